@@ -20,6 +20,8 @@
 
 #include "ui/ui.h"
 #include "engine/engine.h"
+#include "app/kernel_benchmark.h"
+#include <vector>
 
 class App {
     // public for forward declares
@@ -28,7 +30,19 @@ class App {
         enum class Mode {
             PLAY,
             BOT_VS_BOT,
-            BENCHMARK
+            BENCHMARK,
+            KERNEL_BENCHMARK,
+            VERIFY_EVAL,
+            SELF_PLAY,
+            SUITE
+        };
+
+        /// @brief Settings of the 'SELF_PLAY' mode.
+        struct SelfPlay {
+            /// @brief Number of played games.
+            int games;
+            /// @brief File the recorded positions are written to.
+            const char *path;
         };
 
     private:
@@ -41,6 +55,12 @@ class App {
         /// @brief Reversi engine.
         Engine *engine;
 
+        /// @brief Full-width engine the moves of the suite are compared with, nullptr if there is none.
+        Engine *reference;
+
+        /// @brief Settings of the 'SELF_PLAY' mode.
+        SelfPlay self_play;
+
         /// @brief Runs 'PLAY' mode.
         void run_play();
         
@@ -50,13 +70,60 @@ class App {
         /// @brief Runs 'BENCHMARK' mode.
         void run_benchmark();
 
+        /// @brief Runs 'KERNEL_BENCHMARK' mode.
+        void run_kernel_benchmark();
+
+        /// @brief Runs 'VERIFY_EVAL' mode.
+        void run_verify_eval();
+
+        /**
+         * @brief Runs 'SELF_PLAY' mode.
+         * 
+         * The engine plays both colors after a few random opening moves, every position
+         * it searched is recorded with the final disc differential of the game.
+         */
+        void run_self_play();
+
+        /**
+         * @brief Runs 'SUITE' mode.
+         * 
+         * Searches a fixed set of reproducible random positions and reports visited
+         * states and time of every search and of the whole suite, so search
+         * settings can be compared on more than the single benchmark state.
+         * With a reference engine every position is searched by it as well and
+         * the rate of agreeing moves is reported, so the moves lost by the late
+         * move reductions can be measured.
+         */
+        void run_suite();
+
+        /**
+         * @brief Generates reproducible pseudo-random game states.
+         * 
+         * @param count Number of states to generate.
+         * @param seed Seed of the random generator.
+         * 
+         * Each state is reached by playing random legal moves from the initial state,
+         * so the set covers opening, midgame and endgame positions.
+         * Finished games are skipped, at least one color always has a legal move.
+         */
+        static std::vector<Board> random_positions(int count, unsigned int seed);
+
+        /**
+         * @brief Generates kernel samples from reproducible random states.
+         * 
+         * @param count Number of samples to generate.
+         * 
+         * Every sample holds one legal move, so play_move always does real work.
+         */
+        static std::vector<KernelSample> kernel_samples(int count);
+
     public:
         /**
          * @brief Default Terminal constructor.
          * 
          * Loads default settings
          */
-        App(Mode mode, UI *ui, Engine *engine);
+        App(Mode mode, UI *ui, Engine *engine, Engine *reference, SelfPlay self_play);
 
         /// @brief Run the app with loaded settings
         void run();
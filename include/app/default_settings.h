@@ -19,13 +19,17 @@
 #define DEFAULT_SETTINGS_H
 
 #include "app/app.h"
+#include "board/backend.h"
 
 /// @brief Default settings for the whole project.
 struct DefaultSettings {
     static constexpr App::Mode MODE = App::Mode::PLAY;
     static constexpr UI::UIStyle STYLE = UI::UIStyle::BASIC;
     static constexpr Engine::Alg ALG = Engine::Alg::NEGASCOUT;
-    static constexpr Engine::Settings SETTINGS = {10, 0, 1, true, Move_order::Orders::OPTIMIZED};
+    static constexpr Engine::Eval EVAL = Engine::Eval::AUTO;
+    static constexpr Backend::Type BACKEND = Backend::Type::AUTO;
+    static constexpr App::SelfPlay SELF_PLAY = {1000, "selfplay.bin"};
+    static constexpr Engine::Settings SETTINGS = {10, 0, 1, true, Move_order::Orders::OPTIMIZED, false, 0, false, 4, 7, 3, 0, 4, 1, true, 1, true};
 };
 
 #endif
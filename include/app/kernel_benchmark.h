@@ -0,0 +1,98 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef KERNEL_BENCHMARK_H
+#define KERNEL_BENCHMARK_H
+
+#include "board/board.h"
+
+/// @brief Input of one measured kernel call.
+struct KernelSample {
+    /// @brief Measured state.
+    Board state;
+    /// @brief Color used for play_move.
+    bool color;
+    /// @brief Legal move of the color, used for play_move.
+    uint64_t move;
+};
+
+/// @brief Results of the kernel benchmark.
+struct KernelTimes {
+    /// @brief Nanoseconds per find_moves call for both colors.
+    double find_moves;
+    /// @brief Nanoseconds per find_moves_both call.
+    double find_moves_both;
+    /// @brief Nanoseconds per find_stable call.
+    double stable;
+    /// @brief Nanoseconds per find_frontier call, paid by every leaf of the pattern evaluator.
+    double frontier;
+    /// @brief Nanoseconds per play_move call.
+    double play_move;
+    /// @brief Nanoseconds per rate_board call.
+    double rate_board;
+    /// @brief Nanoseconds per rate_board call of the bit-plane evaluator.
+    double bitplane;
+    /// @brief Nanoseconds per rate_board call of the pattern evaluator, zero without loaded weights.
+    double pattern;
+    /// @brief Nanoseconds per child rated by apply_move, rate_board and undo_move.
+    double children;
+    /// @brief Nanoseconds per child rated by batched rate_children.
+    double batch;
+    /// @brief Combined results of all calls, has to be the same for all backends.
+    uint64_t checksum;
+};
+
+/**
+ * @brief Measures speed of board kernels of one backend.
+ * 
+ * @tparam BoardT Board backend to measure.
+ * 
+ * Compiled once for every board backend (like the engines), so the kernels
+ * are inlined into the measured loops the same way as into the search.
+ */
+template <class BoardT>
+class KernelBenchmark {
+    public:
+        /**
+         * @brief Runs the benchmark.
+         * 
+         * @param samples Array of measured states.
+         * @param count Number of states.
+         * @param rounds Number of passes over all states, the fastest pass is reported.
+         */
+        static KernelTimes run(const KernelSample *samples, int count, int rounds);
+
+        /**
+         * @brief Checks incremental and bit-plane evaluation against full rate_board() recompute.
+         * 
+         * @param samples Array of checked states.
+         * @param count Number of states.
+         * @param checked Incremented by the number of performed checks.
+         * @return Number of checks where the scores or the restored state differ.
+         * 
+         * Every legal move of the sample color is applied and undone,
+         * score of IncrementalBoard is compared after both of them.
+         * Score of BitplaneBoard, moves of find_moves_both and the best child
+         * picked by rate_children are compared on every sample. Stable discs
+         * have to match the portable kernel and keep their color after every
+         * legal move, frontier discs and potential moves have to match the portable kernel. Score of PatternBoard is compared with PatternEval::reference()
+         * if weights are loaded.
+         */
+        static uint64_t verify(const KernelSample *samples, int count, uint64_t &checked);
+};
+
+#endif
@@ -0,0 +1,56 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef BACKEND_H
+#define BACKEND_H
+
+/**
+ * @brief Runtime selection of the board backend.
+ * 
+ * All backends enabled at build time are compiled into one executable.
+ * The fastest backend supported by the CPU is selected once at startup,
+ * the engines are instantiated for every backend, so there is no dispatch
+ * overhead during the search.
+ */
+class Backend {
+    public:
+        /// @brief List of board backends.
+        enum class Type {
+            AUTO,
+            NOSIMD,
+            AVX2,
+            AVX512,
+            BMI2,
+            SSE
+        };
+
+        /// @brief Selects the fastest backend supported by the CPU.
+        static Type detect();
+
+        /**
+         * @brief Checks whether the backend can be used.
+         * 
+         * @param type Backend to check.
+         * @return True if the backend was compiled in and the CPU supports it.
+         */
+        static bool available(Type type);
+
+        /// @brief Returns name of the backend as used on the command line.
+        static const char *name(Type type);
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef BITPLANE_BOARD_H
+#define BITPLANE_BOARD_H
+
+#include "board/board.h"
+
+/**
+ * @brief Board evaluated with popcounts of heuristic weight bit-planes.
+ * 
+ * @tparam BoardT Board backend providing the kernels.
+ * 
+ * Board::heuristics_map is split at compile time into signed bit-planes,
+ * plane k holds the squares whose weight has bit k set in its magnitude.
+ * The positional score is then a handful of popcount(bitmap & plane) << k
+ * terms instead of a pass over all 64 squares.
+ * 
+ * Compiled once for every board backend (like the engines).
+ */
+template <class BoardT>
+class BitplaneBoard : public BoardT {
+    public:
+        using BoardT::BoardT;
+
+        /// @brief Constructor copying state of the portable board.
+        explicit BitplaneBoard(const Board &board) : BoardT(board) {}
+
+        /**
+         * @brief Rates the current board state.
+         * 
+         * @return int The heuristic score, same as rate_board() of the backend.
+         */
+        int rate_board() const;
+
+        /// @brief Returns the positional part of the score (white minus black).
+        int position_score() const;
+};
+
+#endif
@@ -25,9 +25,12 @@
  * 
  * The Board class uses two 64-bit integers to represent the positions of pieces
  * on a game board. Each bit in the bitmap represents a space on the board.
+ * 
+ * Implements portable move generation and evaluation kernels. SIMD backends
+ * derive from this class and replace the kernels with their own versions.
  */
 class Board {
-    private:
+    protected:
         /**
          * @brief Colection of pre-defined bit masks.
          * 
@@ -39,8 +42,21 @@ class Board {
             static constexpr uint64_t RIGHT_COL_MASK = 0x7f7f7f7f7f7f7f7f;
             static constexpr uint64_t SIDE_COLS_MASK = 0x7e7e7e7e7e7e7e7e;
             static constexpr uint64_t NO_COL_MASK = 0xffffffffffffffff;
+            static constexpr uint64_t EDGE_MASK = 0xff818181818181ff;
         };
 
+        /**
+         * @brief Finds squares lying on completely filled lines.
+         * 
+         * @param occupied Bitmap of all discs on the board.
+         * @param full Set to 4 bitmaps, one for every direction
+         *             (horizontal, diagonal from bottom left, vertical, diagonal from bottom right).
+         * 
+         * Square is on a full line when it is connected to both edges by occupied squares,
+         * which takes one fill from each edge.
+         */
+        static void full_lines(uint64_t occupied, uint64_t *full);
+
         /**
          * @brief Bitmap representing the positions of white pieces.
          * 
@@ -74,6 +90,13 @@ class Board {
                                                    100,-15, 10,  5,  5, 10,-15,100
         };
 
+        /**
+         * @brief Whether the search keeps the positional score incrementally (see IncrementalBoard).
+         * 
+         * Backends whose full rate_board() is cheaper than updating the score on every move turn it off.
+         */
+        static constexpr bool INCREMENTAL_EVAL = true;
+
         /// @brief Collection of multiple pre-defined usefull states.
         struct States {
             static const Board INITIAL;
@@ -101,6 +124,36 @@ class Board {
          */
         void play_move(bool color, uint64_t move);
 
+        /**
+         * @brief Finds all opponent pieces captured by the move.
+         * 
+         * @param color Boolean indicating the color (true for white, false for black).
+         * @param move Bitmap representing the move to be played.
+         * @return uint64_t Bitmap of the captured pieces, empty if the move is not legal.
+         */
+        uint64_t flips(bool color, uint64_t move) const;
+
+        /**
+         * @brief Plays a move with already known captured pieces.
+         * 
+         * @param color Boolean indicating the color (true for white, false for black).
+         * @param move Bitmap representing the move to be played.
+         * @param flips Captured pieces returned by flips().
+         * 
+         * Together with undo_move() allows the search to walk the tree
+         * on a single board instead of copying it for every child.
+         */
+        void apply_move(bool color, uint64_t move, uint64_t flips);
+
+        /**
+         * @brief Takes back a move played by apply_move().
+         * 
+         * @param color Boolean indicating the color (true for white, false for black).
+         * @param move Bitmap representing the played move.
+         * @param flips Captured pieces passed to apply_move().
+         */
+        void undo_move(bool color, uint64_t move, uint64_t flips);
+
         /**
          * @brief Finds all possible moves for the given color.
          * 
@@ -109,6 +162,64 @@ class Board {
          */
         uint64_t find_moves(bool color) const;
 
+        /**
+         * @brief Finds all possible moves for both colors in a single pass.
+         * 
+         * @param white_moves Set to bitmap of all possible moves for white.
+         * @param black_moves Set to bitmap of all possible moves for black.
+         * 
+         * Used by evaluation, fills of both colors are independent and are interleaved.
+         */
+        void find_moves_both(uint64_t &white_moves, uint64_t &black_moves) const;
+
+        /**
+         * @brief Finds stable discs of both colors, discs which can never be flipped again.
+         * 
+         * @param white_stable Set to bitmap of stable white discs.
+         * @param black_stable Set to bitmap of stable black discs.
+         * 
+         * Result is a lower bound. Disc is stable when in every one of the 4 directions
+         * its line is full, or it is on the edge, or next to a stable disc of its color.
+         * Stable set is grown from nothing until it stops changing.
+         */
+        void find_stable(uint64_t &white_stable, uint64_t &black_stable) const;
+
+        /**
+         * @brief Finds frontier discs and potential moves of both colors.
+         * 
+         * @param white_frontier Set to bitmap of white discs next to an empty square.
+         * @param black_frontier Set to bitmap of black discs next to an empty square.
+         * @param white_potential Set to bitmap of empty squares next to a black disc (potential moves of white).
+         * @param black_potential Set to bitmap of empty squares next to a white disc (potential moves of black).
+         * 
+         * Neighbours are found by smearing the bitmap one square horizontally
+         * and then one square vertically, which covers the diagonals as well.
+         */
+        void find_frontier(uint64_t &white_frontier, uint64_t &black_frontier, uint64_t &white_potential, uint64_t &black_potential) const;
+
+        /// @brief Number of boards processed by one vector operation of mobility_batch(), scalar code has just one.
+        static constexpr int BATCH_WIDTH = 1;
+
+        /**
+         * @brief Computes mobility term of multiple boards at once.
+         * 
+         * @param whites White bitmaps of the boards.
+         * @param blacks Black bitmaps of the boards.
+         * @param count Number of boards, has to be a multiple of BATCH_WIDTH.
+         * @param moves_delta Set to number of white moves minus number of black moves for every board.
+         * 
+         * Boards are stored as structure of arrays, SIMD backends keep one board
+         * in every lane and process one direction at a time for all of them.
+         */
+        static void mobility_batch(const uint64_t *whites, const uint64_t *blacks, int count, int *moves_delta);
+
+        /**
+         * @brief Whether the backend provides extract(bitmap, mask), a single instruction parallel bit extract.
+         * 
+         * Pattern evaluator uses shifts specialized for every pattern mask otherwise (see PatternBoard).
+         */
+        static constexpr bool FAST_EXTRACT = false;
+
         /// @brief White bitmap getter. 
         uint64_t white() const;
 
@@ -130,6 +241,51 @@ class Board {
          */
         int rate_board() const;
 
+        /// @brief Swaps rows of the bitmap, the board is turned upside down.
+        static uint64_t flip_vertical(uint64_t bitmap);
+
+        /// @brief Swaps columns of the bitmap, the board is mirrored left to right.
+        static uint64_t mirror_horizontal(uint64_t bitmap);
+
+        /// @brief Swaps rows and columns of the bitmap, square at row r and column c moves to row c and column r.
+        static uint64_t transpose(uint64_t bitmap);
+
+        /**
+         * @brief Applies one of the 8 symmetries of the board to the bitmap.
+         * 
+         * @param bitmap Transformed bitmap.
+         * @param symmetry Bit 2 transposes the bitmap, bit 1 flips it vertically
+         *                 and bit 0 mirrors it horizontally (in this order).
+         * @return uint64_t Transformed bitmap.
+         */
+        static uint64_t transform(uint64_t bitmap, int symmetry);
+
+        /**
+         * @brief Maps bitmap produced by transform() back to the original orientation.
+         * 
+         * @param bitmap Transformed bitmap (for example move found on the canonical board).
+         * @param symmetry Symmetry passed to transform().
+         * @return uint64_t Bitmap in the original orientation.
+         */
+        static uint64_t untransform(uint64_t bitmap, int symmetry);
+
+        /**
+         * @brief Finds the canonical form of the board.
+         * 
+         * @param canonical Set to the symmetric image with the smallest white bitmap (black breaks ties).
+         * @return int Symmetry transforming this board into the canonical one.
+         * 
+         * All 8 symmetric boards have the same canonical form.
+         */
+        int canonical(Board &canonical) const;
+
+        /**
+         * @brief Generates a hash value shared by all symmetric images of the board.
+         * 
+         * @return uint64_t Hash of the canonical form.
+         */
+        uint64_t canonical_hash() const;
+
         /**
          * @brief Generates a hash value for the current board state.
          * 
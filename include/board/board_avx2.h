@@ -0,0 +1,68 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef BOARD_AVX2_H
+#define BOARD_AVX2_H
+
+#include "board/board.h"
+
+/**
+ * @brief Board backend using AVX2 instructions.
+ * 
+ * Keeps the state of the portable Board and replaces only the move
+ * generation and evaluation kernels. Kernels are not virtual, engines are
+ * instantiated for every backend so the kernels can be inlined into the search.
+ * 
+ * Has to be compiled with AVX2 enabled and used only when the CPU
+ * supports them (see Backend).
+ */
+class BoardAVX2 : public Board {
+    public:
+        using Board::Board;
+
+        /// @brief Constructor copying state of the portable board.
+        explicit BoardAVX2(const Board &board) : Board(board) {}
+
+        /// @copydoc Board::play_move
+        void play_move(bool color, uint64_t move);
+
+        /// @copydoc Board::flips
+        uint64_t flips(bool color, uint64_t move) const;
+
+        /// @copydoc Board::find_moves
+        uint64_t find_moves(bool color) const;
+
+        /// @copydoc Board::find_moves_both
+        void find_moves_both(uint64_t &white_moves, uint64_t &black_moves) const;
+
+        /// @copydoc Board::find_stable
+        void find_stable(uint64_t &white_stable, uint64_t &black_stable) const;
+
+        /// @copydoc Board::find_frontier
+        void find_frontier(uint64_t &white_frontier, uint64_t &black_frontier, uint64_t &white_potential, uint64_t &black_potential) const;
+
+        /// @brief One 64-bit lane per board.
+        static constexpr int BATCH_WIDTH = 4;
+
+        /// @copydoc Board::mobility_batch
+        static void mobility_batch(const uint64_t *whites, const uint64_t *blacks, int count, int *moves_delta);
+
+        /// @copydoc Board::rate_board
+        int rate_board() const;
+};
+
+#endif
@@ -0,0 +1,59 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef BOARD_BMI2_H
+#define BOARD_BMI2_H
+
+#include "board/board_avx2.h"
+
+/**
+ * @brief Board backend using BMI2 (PEXT/PDEP) instructions for playing moves.
+ * 
+ * Lines through the played square are extracted with PEXT, flipped discs are
+ * looked up in precomputed 8-bit line tables and deposited back with PDEP.
+ * Move generation and evaluation are taken from the AVX2 backend.
+ * 
+ * Has to be compiled with AVX2 and BMI2 enabled and used only when the CPU
+ * supports them (see Backend).
+ */
+class BoardBMI2 : public BoardAVX2 {
+    public:
+        using BoardAVX2::BoardAVX2;
+
+        /// @brief Constructor copying state of the portable board.
+        explicit BoardBMI2(const Board &board) : BoardAVX2(board) {}
+
+        /// @copydoc Board::play_move
+        void play_move(bool color, uint64_t move);
+
+        /// @copydoc Board::flips
+        uint64_t flips(bool color, uint64_t move) const;
+
+        /// @brief PEXT is available.
+        static constexpr bool FAST_EXTRACT = true;
+
+        /**
+         * @brief Extracts bits of the bitmap selected by the mask (PEXT).
+         * 
+         * @param bitmap Source bitmap.
+         * @param mask Selected bits.
+         * @return Selected bits packed to the lowest bits, in order of the mask bits.
+         */
+        static uint64_t extract(uint64_t bitmap, uint64_t mask);
+};
+
+#endif
@@ -0,0 +1,52 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "board/board.h"
+#include <concepts>
+#include <cstdint>
+
+/**
+ * @brief Requirements on the search state produced by an evaluator.
+ * 
+ * Evaluator is a class template wrapping a board backend, engines take it
+ * as a template parameter and search on EvalT<BoardT>. Every combination of
+ * backend and evaluator is a separate instance, so the evaluation is inlined
+ * into the leaves without any dispatch. Available evaluators:
+ * 
+ * - TableEval - rate_board() of the backend, the square table with mobility
+ * - IncrementalBoard - the same score with the positional part kept across moves
+ * - BitplaneBoard - the same score computed from heuristic bit-planes
+ * - PatternBoard - pattern weights loaded by PatternEval::load()
+ */
+template <class State>
+concept Evaluator = std::constructible_from<State, const Board &>
+    && requires(State state, const State &view, bool color, uint64_t move, uint64_t flips) {
+        { view.rate_board() } -> std::same_as<int>;
+        { view.find_moves(color) } -> std::same_as<uint64_t>;
+        { view.flips(color, move) } -> std::same_as<uint64_t>;
+        state.apply_move(color, move, flips);
+        state.undo_move(color, move, flips);
+    };
+
+/// @brief Evaluator using the full rate_board() of the backend at every leaf.
+template <class BoardT>
+using TableEval = BoardT;
+
+#endif
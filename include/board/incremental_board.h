@@ -0,0 +1,87 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef INCREMENTAL_BOARD_H
+#define INCREMENTAL_BOARD_H
+
+#include "board/board.h"
+
+/**
+ * @brief Search state keeping the positional score up to date across moves.
+ * 
+ * @tparam BoardT Board backend providing the kernels.
+ * 
+ * rate_board() of the backends sums heuristics_map over all 64 squares at
+ * every leaf. The flip mask of a move tells exactly which squares changed,
+ * so the positional part of the score is updated in apply_move() and
+ * undo_move() from the move square and the flipped squares only. Leaves
+ * then add just the mobility term.
+ * 
+ * Compiled once for every board backend (like the engines).
+ */
+template <class BoardT>
+class IncrementalBoard : public BoardT {
+    private:
+        /// @brief Positional score of the current state (white minus black).
+        int position;
+
+        /// @brief Sums heuristic values of all squares in the bitmap.
+        static int weight(uint64_t bitmap);
+
+    public:
+        /// @brief Default constructor, creates empty board.
+        IncrementalBoard();
+
+        /// @brief Constructor copying state of the portable board and computing its positional score.
+        explicit IncrementalBoard(const Board &board);
+
+        /// @copydoc Board::play_move
+        void play_move(bool color, uint64_t move);
+
+        /// @copydoc Board::apply_move
+        void apply_move(bool color, uint64_t move, uint64_t flips);
+
+        /// @copydoc Board::undo_move
+        void undo_move(bool color, uint64_t move, uint64_t flips);
+
+        /**
+         * @brief Rates the current board state.
+         * 
+         * @return int The heuristic score, same as rate_board() of the backend.
+         * 
+         * Only the mobility term is computed, positional score is already known.
+         */
+        int rate_board() const;
+
+        /// @brief Returns the running positional score.
+        int position_score() const;
+
+        /**
+         * @brief Rates all children of the current state at once.
+         * 
+         * @param color Color playing the moves.
+         * @param moves Bitmap of legal moves of the color, must not be empty.
+         * @return Best rate_board() of the children, maximum for white and minimum for black.
+         * 
+         * Children are generated into structure of arrays, their positional scores are
+         * derived from the running score and mobility of all of them is computed by
+         * mobility_batch() of the backend, several boards per vector operation.
+         */
+        int rate_children(bool color, uint64_t moves) const;
+};
+
+#endif
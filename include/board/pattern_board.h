@@ -0,0 +1,51 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef PATTERN_BOARD_H
+#define PATTERN_BOARD_H
+
+#include "board/board.h"
+
+/**
+ * @brief Board evaluated by the pattern evaluator (see PatternEval).
+ * 
+ * @tparam BoardT Board backend providing the kernels.
+ * 
+ * The eight symmetric images of the board are computed once, pattern
+ * indices are then read with BoardT::extract() (PEXT on the BMI2 backend)
+ * and turned into base-3 table indices with a lookup table.
+ * 
+ * Weights have to be loaded by PatternEval::load() before use.
+ * Compiled once for every board backend (like the engines).
+ */
+template <class BoardT>
+class PatternBoard : public BoardT {
+    public:
+        using BoardT::BoardT;
+
+        /// @brief Constructor copying state of the portable board.
+        explicit PatternBoard(const Board &board) : BoardT(board) {}
+
+        /**
+         * @brief Rates the current board state.
+         * 
+         * @return int Sum of pattern weights and the whole-board feature terms of the current phase, positive values favour white.
+         */
+        int rate_board() const;
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef PATTERN_EVAL_H
+#define PATTERN_EVAL_H
+
+#include <cstdint>
+
+/**
+ * @brief Layout and weights of the pattern evaluator.
+ * 
+ * Every pattern family is a set of squares (edge with both X squares,
+ * corner 3x3 and 2x5 areas, inner lines and diagonals). The family mask
+ * is defined once, its instances are read from the symmetric images of
+ * the board. Each instance is turned into a base-3 index (empty, white,
+ * black per square), the score is the sum of int16_t weights looked up
+ * by those indices. The last FEATURE_COUNT weights of the set multiply
+ * whole-board features patterns cannot see beyond their own squares:
+ * differences of stable discs (see Board::find_stable), frontier discs and
+ * potential moves (see Board::find_frontier). There is one weight set for
+ * every game phase.
+ * 
+ * Weights are loaded from a binary file, see load(). Evaluation itself
+ * is implemented by PatternBoard, so it is compiled for every backend.
+ */
+class PatternEval {
+    public:
+        /**
+         * @brief One pattern family.
+         * 
+         * Symmetry bits select transformations of the board the mask is applied to,
+         * bit 2 transposes the board, bit 1 flips it vertically and bit 0 mirrors it
+         * horizontally (in this order).
+         */
+        struct Family {
+            /// @brief Squares of the pattern on the untransformed board.
+            uint64_t mask;
+            /// @brief Offset of weights of the family inside one phase.
+            int offset;
+            /// @brief Number of instances of the family.
+            int instance_count;
+            /// @brief Symmetry of the board every instance is read from.
+            uint8_t symmetries[8];
+        };
+
+        /// @brief Number of pattern families.
+        static constexpr int FAMILY_COUNT = 11;
+
+        /// @brief All pattern families, every one has 3^squares weights.
+        static constexpr Family families[FAMILY_COUNT] = {
+            {0xe0e0e00000000000,      0, 4, {0, 1, 2, 3}},               // corner 3x3
+            {0xf8f8000000000000,  19683, 8, {0, 1, 2, 3, 4, 5, 6, 7}},   // corner 2x5
+            {0xff42000000000000,  78732, 4, {0, 2, 4, 6}},               // edge with X squares
+            {0x00ff000000000000, 137781, 4, {0, 2, 4, 6}},               // second line
+            {0x0000ff0000000000, 144342, 4, {0, 2, 4, 6}},               // third line
+            {0x000000ff00000000, 150903, 4, {0, 2, 4, 6}},               // fourth line
+            {0x8040201008040201, 157464, 2, {0, 1}},                     // main diagonal
+            {0x4020100804020100, 164025, 4, {0, 1, 2, 3}},               // diagonal of 7 squares
+            {0x2010080402010000, 166212, 4, {0, 1, 2, 3}},               // diagonal of 6 squares
+            {0x1008040201000000, 166941, 4, {0, 1, 2, 3}},               // diagonal of 5 squares
+            {0x0804020100000000, 167184, 4, {0, 1, 2, 3}}                // diagonal of 4 squares
+        };
+
+        /// @brief Number of pattern instances of all families.
+        static constexpr int INSTANCE_COUNT = 46;
+
+        /// @brief Offset of the weight of stable white discs minus stable black discs inside one phase.
+        static constexpr int STABILITY_OFFSET = 167265;
+
+        /// @brief Offset of the weight of white frontier discs minus black frontier discs inside one phase.
+        static constexpr int FRONTIER_OFFSET = 167266;
+
+        /// @brief Offset of the weight of white potential moves minus black potential moves inside one phase.
+        static constexpr int POTENTIAL_OFFSET = 167267;
+
+        /// @brief Number of whole-board features, their weights follow the patterns starting at STABILITY_OFFSET.
+        static constexpr int FEATURE_COUNT = 3;
+
+        /// @brief Number of weights of one game phase.
+        static constexpr int PHASE_SIZE = 167268;
+
+        /// @brief Number of game phases, selected by number of discs on the board.
+        static constexpr int PHASES = 4;
+
+        /// @brief Largest score returned, wins and losses stay outside of the range.
+        static constexpr int MAX_SCORE = 900;
+
+        /// @brief Identification of the weights file.
+        static constexpr char FILE_MAGIC[4] = {'R', 'V', 'P', 'W'};
+
+        /// @brief Version of the weights file layout.
+        static constexpr uint32_t FILE_VERSION = 3;
+
+        /**
+         * @brief Loads weights from a binary file.
+         * 
+         * @param path Path to the file.
+         * @return True if the file was loaded.
+         * 
+         * File starts with FILE_MAGIC followed by little-endian uint32_t version,
+         * phase count and phase size, then PHASES * PHASE_SIZE little-endian
+         * int16_t weights follow. Header has to match the compiled layout.
+         */
+        static bool load(const char *path);
+
+        /**
+         * @brief Writes weights to a binary file in the format read by load().
+         * 
+         * @param path Path to the file.
+         * @param weights PHASES * PHASE_SIZE weights.
+         * @return True if the file was written.
+         */
+        static bool save(const char *path, const int16_t *weights);
+
+        /// @brief Returns loaded weights, nullptr if no weights were loaded.
+        static const int16_t *weights();
+
+        /**
+         * @brief Returns game phase of the board.
+         * 
+         * @param discs Number of discs on the board.
+         */
+        static int phase(int discs);
+
+        /**
+         * @brief Computes weight indices of all instances by walking their squares.
+         * 
+         * @param white White bitmap.
+         * @param black Black bitmap.
+         * @param indices Set to INSTANCE_COUNT indices into the weights of one phase.
+         */
+        static void indices(uint64_t white, uint64_t black, int *indices);
+
+        /**
+         * @brief Computes whole-board features with the portable kernels.
+         * 
+         * @param white White bitmap.
+         * @param black Black bitmap.
+         * @param features Set to FEATURE_COUNT values (white minus black), in the order of their weights.
+         */
+        static void features(uint64_t white, uint64_t black, int *features);
+
+        /**
+         * @brief Straightforward evaluation walking every square of every instance.
+         * 
+         * @param white White bitmap.
+         * @param black Black bitmap.
+         * @return Pattern score, used to verify PatternBoard of all backends.
+         */
+        static int reference(uint64_t white, uint64_t black);
+};
+
+#endif
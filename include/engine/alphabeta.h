@@ -21,23 +21,28 @@
 #include "engine/engine.h"
 #include "engine/move_order.h"
 #include "engine/transposition_table.h"
+#include "engine/eval_cache.h"
+#include "engine/search_stats.h"
+#include "board/evaluator.h"
 
 /**
  * @brief Class implementing negascout game-tree search.
+ * 
+ * @tparam BoardT Board backend providing move generation kernels.
+ * @tparam EvalT Evaluator wrapping the backend into the search state (see Evaluator).
  */
+template <class BoardT, template <class> class EvalT>
 class Alphabeta : public Engine {
     private:
-        /// @brief Number of heuristic evaluations performed in the last search (used for statistics).
-        unsigned long long int last_heuristic_count;
+        /// @brief Search state, the backend with the evaluation of the evaluator.
+        using State = EvalT<BoardT>;
+        static_assert(Evaluator<State>, "search state has to satisfy the evaluator requirements");
 
-        /// @brief Number of game states evaluated in the last search (used for statistics).
-        unsigned long long int last_state_count;
+        /// @brief Counters collected in the last search (used for statistics).
+        SearchStats last_stats;
 
-        /// @brief Number of heuristic evaluations performed in the lifetime of class instance (used for statistics).
-        unsigned long long int total_heuristic_count;
-
-        /// @brief Number of game states evaluated in the lifetime of class instance (used for statistics).
-        unsigned long long int total_state_count;
+        /// @brief Counters collected in the lifetime of class instance (used for statistics).
+        SearchStats total_stats;
         
         /// @brief Array storing the order in which possible moves are evaluated to optimize search performance.
         Move_order move_order;
@@ -45,10 +50,19 @@ class Alphabeta : public Engine {
         /// @brief The transposition table used to store previously evaluated game states and their results, improving search efficiency.
         TranspositionTable transposition_table;
 
+        /// @brief Scores of already rated leaves.
+        EvalCache eval_cache;
+
+        /// @brief Best move of the last search, the table does not keep moves to follow the line further.
+        PrincipalVariation last_pv;
+
+        /// @brief Score of the best move of the last search.
+        RootScores last_scores;
+
         /**
          * @brief Negascout search algorithm (a variant of alpha-beta pruning) used to find the best move.
          * 
-         * @param state A pointer to the current game board state.
+         * @param state Current game board state, moves are played and taken back on it, so it is unchanged on return.
          * @param depth The maximum depth of the search tree.
          * @param cur_color The current player's color (true for one color, false for the other).
          * @param alpha The alpha value for alpha-beta pruning.
@@ -56,13 +70,19 @@ class Alphabeta : public Engine {
          * @param end_board Flag indicating whether the current board state is the final state.
          * @return The evaluated score of the board.
          */
-        int alphabeta(Board state, int depth, bool cur_color, int alpha, int beta, bool end_board);
+        int alphabeta(State &state, int depth, bool cur_color, int alpha, int beta, bool end_board);
 
     public:
         /// @brief Constructor initializing settings. 
         explicit Alphabeta(Engine::Settings settings);
         
         uint64_t search(Board state, bool color) override;
+
+        const SearchStats &get_last_stats() const override;
+
+        const PrincipalVariation &get_last_pv() const override;
+
+        const RootScores &get_last_scores() const override;
 };
 
 #endif
\ No newline at end of file
@@ -19,6 +19,9 @@
 #define ENGINE_H
 
 #include "board/board.h"
+#include "engine/principal_variation.h"
+#include "engine/root_scores.h"
+#include "engine/search_stats.h"
 #include "move_order.h"
 
 /**
@@ -33,6 +36,30 @@ class Engine {
             int thread_count;
             bool transposition_enable;
             const uint8_t *order;
+            /// @brief Search statistics are not printed (used when the engine plays many games).
+            bool quiet;
+            /// @brief Size of the leaf evaluation cache in MiB, 0 disables the cache (see EvalCache).
+            int eval_cache_size;
+            /// @brief Transposition table is keyed on the canonical form, so symmetric positions share entries.
+            bool canonical_tt;
+            /// @brief Minimal remaining depth at which moves are ordered by mobility of the opponent (fastest-first), 0 disables it.
+            int fastest_first_depth;
+            /// @brief Minimal remaining depth of nodes without a hash move searched by internal iterative deepening, 0 disables it.
+            int iid_depth;
+            /// @brief Depth reduction of the internal iterative deepening search.
+            int iid_reduction;
+            /// @brief Minimal remaining depth at which late moves are searched to reduced depth first (see Reductions), 0 disables it.
+            int lmr_depth;
+            /// @brief Number of moves searched to the full depth before the reductions start.
+            int lmr_moves;
+            /// @brief Largest depth reduction of a late move.
+            int lmr_reduction;
+            /// @brief Root is searched to every second depth up to the search depth, shallower searches order the deeper ones.
+            bool iterative_deepening;
+            /// @brief Number of best root moves scored exactly (multi-PV), more than one uses the parallel engine.
+            int multipv;
+            /// @brief Engine searches on the time of the opponent in the play mode (see ponder).
+            bool ponder;
         };
 
         /// @brief List of avaible algorithms.
@@ -41,6 +68,16 @@ class Engine {
             NEGASCOUT
         };
 
+        /// @brief List of available evaluators (see Evaluator).
+        enum class Eval {
+            /// @brief Square table, kept incrementally if the backend benefits from it.
+            AUTO,
+            TABLE,
+            INCREMENTAL,
+            BITPLANE,
+            PATTERN
+        };
+
         /// @brief Virtual deconstructor to ensure all derived classes can deleted properly.
         virtual ~Engine() {};
 
@@ -54,6 +91,33 @@ class Engine {
          */
         virtual uint64_t search(Board state, bool color) = 0;
 
+        /// @brief Returns counters collected in the last search.
+        virtual const SearchStats &get_last_stats() const = 0;
+
+        /// @brief Returns expected line of play found by the last search, starting with the returned move.
+        virtual const PrincipalVariation &get_last_pv() const = 0;
+
+        /// @brief Returns scores of the moves of the position searched last, best first.
+        virtual const RootScores &get_last_scores() const = 0;
+
+        /**
+         * @brief Searches the position while the opponent is thinking (pondering).
+         * 
+         * @param state Game board state with the opponent at turn.
+         * @param color Color of the opponent.
+         * 
+         * Runs until stop_ponder() is called from another thread or the position
+         * is searched one ply deeper than the search depth. The transposition table
+         * filled by pondering is kept for the next search and the predicted reply of
+         * the opponent continues the principal variation, so the next search is fast
+         * if the opponent plays it. No other method may be called until it returns.
+         * Engines which do not ponder return immediately.
+         */
+        virtual void ponder(Board /*state*/, bool /*color*/) {}
+
+        /// @brief Stops pondering as soon as possible, threadsafe.
+        virtual void stop_ponder() {}
+
     protected:
         /// @brief Loaded search settings.
         Settings settings;
@@ -0,0 +1,103 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef EVAL_CACHE_H
+#define EVAL_CACHE_H
+
+#include "engine/search_stats.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Direct-mapped cache of leaf evaluations.
+ * 
+ * Transposition table is not used in the last plies, so leaves reached
+ * through different move orders are rated again. Every entry is a single
+ * 64-bit word holding the upper 48 bits of the board hash and the score,
+ * entries are read and written with relaxed atomics, so threads of the
+ * parallel engine share the cache without locks and can never see
+ * a torn entry. Colliding boards simply replace each other.
+ * 
+ * Scores do not depend on the search, so the cache is kept between searches.
+ */
+class EvalCache {
+    private:
+        /// @brief Entries of the cache, empty when the cache is disabled.
+        std::unique_ptr<std::atomic<uint64_t>[]> entries;
+
+        /// @brief Number of entries minus one, entry count is a power of two.
+        uint64_t mask;
+
+    public:
+        /**
+         * @brief Allocates the cache.
+         * 
+         * @param size Size of the cache in MiB, rounded down to a power of two, 0 disables the cache.
+         * 
+         * Constructor and destructor are defined out of line, see TranspositionTable.
+         */
+        explicit EvalCache(int size);
+        ~EvalCache();
+
+        /// @brief Returns true if the cache was allocated.
+        bool enabled() const;
+
+        /**
+         * @brief Looks the board up.
+         * 
+         * @param hash Hash of the board (see Board::hash).
+         * @param score Set to the cached score if the board was found.
+         * @return True if the board was found.
+         */
+        bool get(uint64_t hash, int &score) const;
+
+        /**
+         * @brief Stores score of the board, replacing whatever was in its entry.
+         * 
+         * @param hash Hash of the board (see Board::hash).
+         * @param score Score of the board, has to fit into 16 bits.
+         */
+        void insert(uint64_t hash, int score);
+
+        /**
+         * @brief Rates the leaf through the cache, shared by all engines.
+         * 
+         * @tparam State Search state of the engine, provides hash() and rate_board().
+         * @param state Rated leaf.
+         * @param stats Statistics counting the probes and hits of the cache.
+         * @return Score of the leaf, computed and stored on a miss.
+         */
+        template <class State>
+        int rate_board(const State &state, SearchStats &stats);
+};
+
+template <class State>
+int EvalCache::rate_board(const State &state, SearchStats &stats) {
+    uint64_t hash = state.hash();
+    int score;
+    stats.eval_cache_probe_count++;
+    if (get(hash, score)) {
+        stats.eval_cache_hit_count++;
+        return score;
+    }
+    score = state.rate_board();
+    insert(hash, score);
+    return score;
+}
+
+#endif
@@ -21,7 +21,12 @@
 #include "engine/engine.h"
 #include "engine/move_order.h"
 #include "engine/transposition_table.h"
+#include "engine/eval_cache.h"
+#include "engine/reductions.h"
+#include "engine/search_stats.h"
+#include "board/evaluator.h"
 #include "utils/thread_manager.h"
+#include <atomic>
 #include <mutex>
 
 // IMPORTANT
@@ -30,20 +35,22 @@
 
 /**
  * @brief Class implementing negascout game-tree search.
+ * 
+ * @tparam BoardT Board backend providing move generation kernels.
+ * @tparam EvalT Evaluator wrapping the backend into the search state (see Evaluator).
  */
+template <class BoardT, template <class> class EvalT>
 class Negascout : public Engine {
     private:
-        /// @brief Number of heuristic evaluations performed in the last search (used for statistics).
-        unsigned long long int last_heuristic_count;
-
-        /// @brief Number of game states evaluated in the last search (used for statistics).
-        unsigned long long int last_state_count;
+        /// @brief Search state, the backend with the evaluation of the evaluator.
+        using State = EvalT<BoardT>;
+        static_assert(Evaluator<State>, "search state has to satisfy the evaluator requirements");
 
-        /// @brief Number of heuristic evaluations performed in the lifetime of class instance (used for statistics).
-        unsigned long long int total_heuristic_count;
+        /// @brief Counters collected in the last search (used for statistics).
+        SearchStats last_stats;
 
-        /// @brief Number of game states evaluated in the lifetime of class instance (used for statistics).
-        unsigned long long int total_state_count;
+        /// @brief Counters collected in the lifetime of class instance (used for statistics).
+        SearchStats total_stats;
         
         /// @brief Array storing the order in which possible moves are evaluated to optimize search performance.
         Move_order move_order;
@@ -51,10 +58,34 @@ class Negascout : public Engine {
         /// @brief The transposition table used to store previously evaluated game states and their results, improving search efficiency.
         TranspositionTable transposition_table;
 
+        /// @brief Scores of already rated leaves.
+        EvalCache eval_cache;
+
+        /// @brief Depth reductions of late moves.
+        Reductions reductions;
+
+        /// @brief Expected line of play found by the last search.
+        PrincipalVariation last_pv;
+
+        /// @brief Score of the best move of the last search, exact scores of more moves are found by the parallel engine.
+        RootScores last_scores;
+
+        /// @brief Set to abort pondering, aborted nodes are not stored in the transposition table.
+        std::atomic<bool> stopped = false;
+
+        /// @brief Transposition table was filled by pondering and is kept for the next search.
+        bool pondered = false;
+
+        /// @brief Position the last principal variation starts from.
+        Board pv_board;
+
+        /// @brief Color at turn in the position the last principal variation starts from.
+        bool pv_color = false;
+
         /**
          * @brief Negascout search algorithm (a variant of alpha-beta pruning) used to find the best move.
          * 
-         * @param state A pointer to the current game board state.
+         * @param state Current game board state, moves are played and taken back on it, so it is unchanged on return.
          * @param depth The maximum depth of the search tree.
          * @param cur_color The current player's color (true for one color, false for the other).
          * @param alpha The alpha value for alpha-beta pruning.
@@ -62,13 +93,80 @@ class Negascout : public Engine {
          * @param end_board Flag indicating whether the current board state is the final state.
          * @return The evaluated score of the board.
          */
-        int negascout(Board state, int depth, bool cur_color, int alpha, int beta, bool end_board);
+        int negascout(State &state, int depth, bool cur_color, int alpha, int beta, bool end_board);
+
+        /**
+         * @brief Search of the last plies before the horizon, specialized at compile time.
+         * 
+         * @tparam depth Remaining depth, at most 2.
+         * @tparam cur_color The current player's color.
+         * @param state Current game board state, unchanged on return.
+         * @param alpha The alpha value for alpha-beta pruning.
+         * @param beta The beta value for alpha-beta pruning.
+         * @param end_board Flag indicating whether the current board state is the final state.
+         * @return The evaluated score of the board.
+         * 
+         * Plain alpha-beta without the transposition table, null window
+         * re-searches do not pay off this close to the leaves. Every depth
+         * and color is a separate instance, so the children are evaluated
+         * by inlined code instead of recursive calls of the generic search.
+         */
+        template <int depth, bool cur_color>
+        int frontier(State &state, int alpha, int beta, bool end_board);
+
+        /**
+         * @brief Searches all moves of the root position.
+         * 
+         * @param state Current game board state, unchanged on return.
+         * @param color The current player's color.
+         * @param depth Depth of the search.
+         * @param first_move Move searched first, usually the best move of the previous iteration.
+         * @param best_move Set to the best move, 0 if there is no legal move.
+         * @return The evaluated score of the best move.
+         */
+        int search_root(State &state, bool color, int depth, uint64_t first_move, uint64_t &best_move);
+
+        /**
+         * @brief Collects the principal variation.
+         * 
+         * @param state Game board state of the root.
+         * @param color The current player's color.
+         * @param depth Depth of the search.
+         * @param move Best move of the root.
+         * @param pv Set to the collected line.
+         * 
+         * Follows the best moves stored in the transposition table, the last plies
+         * are not stored there and are searched again with a full window.
+         */
+        void collect_pv(State state, bool color, int depth, uint64_t move, PrincipalVariation &pv);
+
+        /**
+         * @brief Looks the position up on the principal variation of the last search.
+         * 
+         * @param state Searched game board state.
+         * @param color The current player's color.
+         * @return Move of the principal variation in the position, 0 if the position is not on it.
+         * 
+         * Moves of the rest of the line are stored as hash moves of the positions not yet in the transposition table,
+         * so the predicted line is searched first when the game follows it.
+         */
+        uint64_t seed_pv(const State &state, bool color);
 
     public:
         /// @brief Constructor initializing settings. 
         explicit Negascout(Engine::Settings settings);
 
         uint64_t search(Board state, bool color) override;
+
+        const SearchStats &get_last_stats() const override;
+
+        const PrincipalVariation &get_last_pv() const override;
+
+        const RootScores &get_last_scores() const override;
+
+        void ponder(Board state, bool color) override;
+
+        void stop_ponder() override;
 };
 
 /**
@@ -78,15 +176,53 @@ class Negascout : public Engine {
  * introduces significant overhead, since parallel search has a huge
  * impact on pruning performance. Does not scale past 2-4 cores with only
  * small 10%-20% performance improvements over single threaded version.
+ * 
+ * @tparam BoardT Board backend providing move generation kernels.
+ * @tparam EvalT Evaluator wrapping the backend into the search state (see Evaluator).
  */
+template <class BoardT, template <class> class EvalT>
 class NegascoutParallel : public Engine {
     private:
+        /// @brief Search state, the backend with the evaluation of the evaluator.
+        using State = EvalT<BoardT>;
+        static_assert(Evaluator<State>, "search state has to satisfy the evaluator requirements");
+
+        /// @brief Counters collected in the last search (used for statistics).
+        SearchStats last_stats;
+
+        /// @brief Counters collected in the lifetime of class instance (used for statistics).
+        SearchStats total_stats;
+
         /// @brief Array storing the order in which possible moves are evaluated to optimize search performance.
         Move_order move_order;
 
         /// @brief The transposition table used to store previously evaluated game states and their results, improving search efficiency.
         TranspositionTableParallel transposition_table;
 
+        /// @brief Scores of already rated leaves, shared by all threads.
+        EvalCache eval_cache;
+
+        /// @brief Depth reductions of late moves.
+        Reductions reductions;
+
+        /// @brief Expected line of play found by the last search.
+        PrincipalVariation last_pv;
+
+        /// @brief Position the last principal variation starts from.
+        Board pv_board;
+
+        /// @brief Color at turn in the position the last principal variation starts from.
+        bool pv_color = false;
+
+        /// @brief Scores of the root moves found by the last search.
+        RootScores last_scores;
+
+        /// @brief Exact scores of the best root moves searched so far, best first, guarded by the mutex.
+        int best_scores[RootScores::MAX_MOVES];
+
+        /// @brief Number of exact scores, at most settings.multipv.
+        int best_count = 0;
+
         /// @brief Mutex for accessing shared resources during search.
         std::mutex m;
 
@@ -96,30 +232,98 @@ class NegascoutParallel : public Engine {
         /**
          * @brief Negascout search algorithm (a variant of alpha-beta pruning) used to find the best move.
          * 
-         * @param state A pointer to the current game board state.
+         * @param state Current game board state, moves are played and taken back on it, so it is unchanged on return.
          * @param depth The maximum depth of the search tree.
          * @param cur_color The current player's color (true for one color, false for the other).
          * @param alpha The alpha value for alpha-beta pruning.
          * @param beta The beta value for alpha-beta pruning.
          * @param end_board Flag indicating whether the current board state is the final state.
+         * @param stats Counters owned by the calling thread.
          * @return The evaluated score of the board.
          */
-        int negascout(Board state, int depth, bool cur_color, int alpha, int beta, bool end_board);
+        int negascout(State &state, int depth, bool cur_color, int alpha, int beta, bool end_board, SearchStats &stats);
+
+        /**
+         * @brief Search of the last plies before the horizon, specialized at compile time.
+         * 
+         * @tparam depth Remaining depth, at most 2.
+         * @tparam cur_color The current player's color.
+         * @param state Current game board state, unchanged on return.
+         * @param alpha The alpha value for alpha-beta pruning.
+         * @param beta The beta value for alpha-beta pruning.
+         * @param end_board Flag indicating whether the current board state is the final state.
+         * @param stats Counters owned by the calling thread.
+         * @return The evaluated score of the board.
+         * 
+         * Plain alpha-beta without the transposition table, null window
+         * re-searches do not pay off this close to the leaves. Every depth
+         * and color is a separate instance, so the children are evaluated
+         * by inlined code instead of recursive calls of the generic search.
+         */
+        template <int depth, bool cur_color>
+        int frontier(State &state, int alpha, int beta, bool end_board, SearchStats &stats);
+
+        /**
+         * @brief Collects the principal variation into last_pv.
+         * 
+         * @param state Game board state of the root.
+         * @param color The current player's color.
+         * @param move Best move of the root.
+         * 
+         * Follows the best moves stored in the transposition table, the last plies
+         * are not stored there and are searched again with a full window.
+         */
+        void collect_pv(State state, bool color, uint64_t move);
+
+        /**
+         * @brief Looks the position up on the principal variation of the last search.
+         * 
+         * @param state Searched game board state.
+         * @param color The current player's color.
+         * @return Move of the principal variation in the position, 0 if the position is not on it.
+         * 
+         * Moves of the rest of the line are stored as hash moves of the positions not yet in the transposition table,
+         * so the predicted line is searched first when the game follows it.
+         */
+        uint64_t seed_pv(const State &state, bool color);
+
+        /**
+         * @brief Returns score a root move has to beat to be among the best moves.
+         * 
+         * @param color The current player's color.
+         * @return Worst of the best exact scores, -1000 or 1000 if there are not enough of them yet.
+         * 
+         * Caller has to hold the mutex.
+         */
+        int threshold(bool color) const;
+
+        /**
+         * @brief Adds exact score of a root move to the best scores, only the best settings.multipv are kept.
+         * 
+         * Caller has to hold the mutex.
+         */
+        void add_score(bool color, int score);
 
         /// @brief Struct used to pass arguments to threaded search_move function.
         struct SearchArg {
-            Board state;
+            State state;
             uint64_t move;
             bool cur_color;
-            int *alpha;
-            int *beta;
             int ret;
+            /// @brief Score was searched with a window containing it, otherwise it is only a bound.
+            bool exact;
             NegascoutParallel *obj;
+            /// @brief Counters of this task, padded to its own cache line.
+            SearchStats stats;
         };
 
         /**
          * @brief Searches one move, used by parallel engine.
          * 
+         * The move is searched with a null window at the threshold and gets
+         * an exact score only if it fails high, so with a single best move
+         * this is the usual negascout root.
+         * 
          * Threadsafe.
          */
         static void search_move(void *args);
@@ -129,6 +333,12 @@ class NegascoutParallel : public Engine {
         explicit NegascoutParallel(Engine::Settings settings);
 
         uint64_t search(Board state, bool color) override;
+
+        const SearchStats &get_last_stats() const override;
+
+        const PrincipalVariation &get_last_pv() const override;
+
+        const RootScores &get_last_scores() const override;
 };
 
 #endif
@@ -0,0 +1,51 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef PRINCIPAL_VARIATION_H
+#define PRINCIPAL_VARIATION_H
+
+#include <cstdint>
+
+/**
+ * @brief Expected line of play found by the search.
+ *
+ * Moves of both colors alternate starting with the color at turn in the
+ * searched position, a pass is stored as 0. Kept in a fixed array, so the
+ * engines compiled for every board backend do not instantiate std containers.
+ */
+struct PrincipalVariation {
+    /// @brief Upper bound of the number of moves in the line.
+    static constexpr int MAX_LENGTH = 64;
+
+    /// @brief Number of valid moves.
+    int length = 0;
+
+    /// @brief Moves of the line as bitboards, 0 is a pass.
+    uint64_t moves[MAX_LENGTH] = {};
+
+    /**
+     * @brief Prints the line to the standard output.
+     *
+     * @param depth Depth of the search which found the line.
+     * @param eval Evaluation of the line.
+     *
+     * Moves are printed as column and row, the same way they are entered in the play mode.
+     */
+    void print(int depth, int eval) const;
+};
+
+#endif
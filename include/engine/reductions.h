@@ -0,0 +1,65 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef REDUCTIONS_H
+#define REDUCTIONS_H
+
+#include <cstdint>
+
+/**
+ * @brief Table of depth reductions for late moves (late move reductions).
+ * 
+ * Moves late in the order are rarely the best ones, so they are first searched
+ * with a null window to a reduced depth and only re-searched to the full depth
+ * if the reduced search fails high. The reduction depends on the remaining
+ * depth and on the index of the move in the order, it grows by one ply after
+ * every group of full-width moves up to the maximal reduction, and the reduced
+ * search never ends below the horizon.
+ */
+class Reductions {
+    public:
+        /// @brief Largest remaining depth covered by the table.
+        static constexpr int MAX_DEPTH = 64;
+
+        /// @brief Largest number of moves covered by the table.
+        static constexpr int MAX_MOVES = 64;
+
+    private:
+        /// @brief Reductions indexed by remaining depth and index of the move.
+        uint8_t table[MAX_DEPTH][MAX_MOVES];
+
+    public:
+        /**
+         * @brief Fills the table.
+         * 
+         * @param min_depth Minimal remaining depth at which moves are reduced, 0 disables the reductions.
+         * @param full_moves Number of moves searched to the full depth, also size of the groups of moves with the same reduction.
+         * @param max_reduction Largest reduction in plies.
+         */
+        Reductions(int min_depth, int full_moves, int max_reduction);
+
+        /**
+         * @brief Returns the reduction of the move.
+         * 
+         * @param depth Remaining depth of the node.
+         * @param index Index of the move in the search order.
+         * @return Reduction in plies, 0 if the move is searched to the full depth.
+         */
+        int get(int depth, int index) const;
+};
+
+#endif
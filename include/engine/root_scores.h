@@ -0,0 +1,63 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef ROOT_SCORES_H
+#define ROOT_SCORES_H
+
+#include <cstdint>
+
+/**
+ * @brief Scores of the moves of the searched position (multi-PV analysis).
+ *
+ * Moves are sorted from the best one for the color at turn by their score,
+ * the requested number of best moves go first with exact scores. The other
+ * moves were only proven not to be among them, their score is exact if it was
+ * searched before there were enough best moves and a bound otherwise. Kept in
+ * a fixed array for the same reason as PrincipalVariation.
+ */
+struct RootScores {
+    /// @brief Upper bound of legal moves in one position.
+    static constexpr int MAX_MOVES = 64;
+
+    /// @brief Score of one move.
+    struct MoveScore {
+        /// @brief Move as a bitboard.
+        uint64_t move;
+        /// @brief Score of the move, an upper bound for white and a lower bound for black if not exact.
+        int score;
+        /// @brief Score was searched with a window containing it.
+        bool exact;
+    };
+
+    /// @brief Color at turn in the searched position, white (true) maximizes the score.
+    bool color = false;
+
+    /// @brief Number of valid scores.
+    int count = 0;
+
+    /// @brief Scores of the moves, best first.
+    MoveScore moves[MAX_MOVES] = {};
+
+    /**
+     * @brief Prints the scores to the standard output.
+     *
+     * Moves are printed as column and row, bounds are marked by the comparison they satisfy.
+     */
+    void print() const;
+};
+
+#endif
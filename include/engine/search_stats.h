@@ -0,0 +1,84 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+/**
+ * @brief Collection of counters gathered during the search (used for statistics).
+ *
+ * Aligned to the size of a cache line, so the parallel engine can keep
+ * one instance per thread without the threads invalidating each other's
+ * cache lines (false sharing). Per-thread instances are summed up once
+ * the search is finished.
+ */
+struct alignas(64) SearchStats {
+    /// @brief Number of game states visited.
+    unsigned long long int state_count = 0;
+
+    /// @brief Number of heuristic evaluations performed.
+    unsigned long long int heuristic_count = 0;
+
+    /// @brief Number of states looked up in the transposition table.
+    unsigned long long int tt_probe_count = 0;
+
+    /// @brief Number of states resolved by the transposition table.
+    unsigned long long int tt_hit_count = 0;
+
+    /// @brief Number of beta cutoffs.
+    unsigned long long int cutoff_count = 0;
+
+    /// @brief Number of endgame states resolved by counting stable discs.
+    unsigned long long int stability_cutoff_count = 0;
+
+    /// @brief Number of reduced-depth searches run to find the first move of a node (internal iterative deepening).
+    unsigned long long int iid_count = 0;
+
+    /// @brief Number of internal iterative deepening searches which found a move, those failing low do not.
+    unsigned long long int iid_move_count = 0;
+
+    /// @brief Number of nodes where the move found by internal iterative deepening stayed the best one.
+    unsigned long long int iid_best_count = 0;
+
+    /// @brief Number of late moves searched to a reduced depth.
+    unsigned long long int lmr_count = 0;
+
+    /// @brief Number of reduced searches which failed high and were repeated to the full depth.
+    unsigned long long int lmr_research_count = 0;
+
+    /// @brief Number of leaves looked up in the evaluation cache.
+    unsigned long long int eval_cache_probe_count = 0;
+
+    /// @brief Number of leaves found in the evaluation cache.
+    unsigned long long int eval_cache_hit_count = 0;
+
+    /// @brief Adds counters of another instance to this one.
+    SearchStats &operator+=(const SearchStats &other);
+
+    /**
+     * @brief Prints all counters and the search result to the standard output.
+     *
+     * @param seconds Duration of the search, used to compute states and leaves per second.
+     * @param eval Evaluation of the best move.
+     *
+     * Printing is kept out of the engines, those are compiled for every
+     * board backend and must not pull in iostream static initialization.
+     */
+    void print(double seconds, int eval) const;
+};
+
+#endif
@@ -39,6 +39,10 @@ class TranspositionTable {
             int score;
             /// @brief The type of the entry (exact, lower bound, upper bound).
             int type;
+            /// @brief Remaining depth of the search which stored the entry.
+            int depth;
+            /// @brief Best move found by the search, 0 if no move raised the bound.
+            uint64_t move;
         };
 
         /// @brief The internal map storing hash-entry pairs.
@@ -48,6 +52,15 @@ class TranspositionTable {
         /// @brief Constant representing that entry was not found.
         static constexpr int NOT_FOUND = 1111;
 
+        /**
+         * @brief Constructor and destructor are defined out of line.
+         * 
+         * Engines are compiled with different instruction sets for every board backend,
+         * map code has to be generated only once, in the generic translation unit.
+         */
+        TranspositionTable();
+        ~TranspositionTable();
+
         /// @brief Removes all entries stored in the transposition table.
         void clear();
 
@@ -58,10 +71,25 @@ class TranspositionTable {
          * @param score The score associated with the game state.
          * @param alpha The alpha value for alpha-beta pruning.
          * @param beta The beta value for alpha-beta pruning.
+         * @param depth Remaining depth of the search of the game state.
+         * @param move Best move of the game state, 0 if unknown.
          * 
          * Score, alpha and beta values are used to determine entry type.
+         * An existing entry of the game state is always replaced, even by a shallower
+         * search, the last search of the state is the most relevant for move ordering.
+         */
+        void insert(uint64_t hash, int score, int alpha, int beta, int depth, uint64_t move);
+
+        /**
+         * @brief Stores hash move of a game state which is not in the table yet.
+         * 
+         * @param hash The unique hash value identifying the game state.
+         * @param move Move searched first in the game state.
+         * 
+         * Entry has no score, existing entries are left unchanged, so scores
+         * of deeper searches (for example pondering) are not lost.
          */
-        void insert(uint64_t hash, int score, int alpha, int beta);
+        void insert_move(uint64_t hash, uint64_t move);
 
         /**
          * @brief Retrieves an entry from the transposition table.
@@ -69,12 +97,18 @@ class TranspositionTable {
          * @param hash The unique hash value identifying the game state.
          * @param alpha The alpha value for alpha-beta pruning.
          * @param beta The beta value for alpha-beta pruning.
+         * @param depth Remaining depth the score is needed for.
+         * @param move Set to the stored best move (hash move), 0 if the entry is not found.
          * @return int The score associated with the game state, or NOT_FOUND if the entry is not found.
          * 
          * This method retrieves the score of the game state identified by the
-         * given hash value. If the entry is not found, it returns NOT_FOUND.
+         * given hash value. If the entry is not found, or it was stored by
+         * a shallower search (see internal iterative deepening), it returns NOT_FOUND.
+         * The move of a shallower entry is still returned for move ordering.
+         * Entries are always replaced on insert, so the move comes from the last
+         * search of the state, which may be shallower than an earlier one.
          */
-        int get(uint64_t hash, int alpha, int beta);
+        int get(uint64_t hash, int alpha, int beta, int depth, uint64_t &move);
 };
 
 /**
@@ -95,6 +129,10 @@ class TranspositionTableParallel {
             int score;
             /// @brief The type of the entry (exact, lower bound, upper bound).
             int type;
+            /// @brief Remaining depth of the search which stored the entry.
+            int depth;
+            /// @brief Best move found by the search, 0 if no move raised the bound.
+            uint64_t move;
         };
 
         /// @brief Number of used maps, reduces overhead.
@@ -120,7 +158,9 @@ class TranspositionTableParallel {
         /// @brief Constant representing that entry was not found.
         static constexpr int NOT_FOUND = 1111;
 
+        /// @brief Constructor and destructor are defined out of line, see TranspositionTable.
         TranspositionTableParallel();
+        ~TranspositionTableParallel();
 
         /// @brief Removes all entries stored in the transposition table.
         void clear();
@@ -132,10 +172,25 @@ class TranspositionTableParallel {
          * @param score The score associated with the game state.
          * @param alpha The alpha value for alpha-beta pruning.
          * @param beta The beta value for alpha-beta pruning.
+         * @param depth Remaining depth of the search of the game state.
+         * @param move Best move of the game state, 0 if unknown.
          * 
          * Score, alpha and beta values are used to determine entry type.
+         * An existing entry of the game state is always replaced, even by a shallower
+         * search, the last search of the state is the most relevant for move ordering.
+         */
+        void insert(uint64_t hash, int score, int alpha, int beta, int depth, uint64_t move);
+
+        /**
+         * @brief Stores hash move of a game state which is not in the table yet.
+         * 
+         * @param hash The unique hash value identifying the game state.
+         * @param move Move searched first in the game state.
+         * 
+         * Entry has no score, existing entries are left unchanged, so scores
+         * of deeper searches (for example pondering) are not lost.
          */
-        void insert(uint64_t hash, int score, int alpha, int beta);
+        void insert_move(uint64_t hash, uint64_t move);
 
         /**
          * @brief Retrieves an entry from the transposition table.
@@ -143,12 +198,18 @@ class TranspositionTableParallel {
          * @param hash The unique hash value identifying the game state.
          * @param alpha The alpha value for alpha-beta pruning.
          * @param beta The beta value for alpha-beta pruning.
+         * @param depth Remaining depth the score is needed for.
+         * @param move Set to the stored best move (hash move), 0 if the entry is not found.
          * @return int The score associated with the game state, or NOT_FOUND if the entry is not found.
          * 
          * This method retrieves the score of the game state identified by the
-         * given hash value. If the entry is not found, it returns NOT_FOUND.
+         * given hash value. If the entry is not found, or it was stored by
+         * a shallower search (see internal iterative deepening), it returns NOT_FOUND.
+         * The move of a shallower entry is still returned for move ordering.
+         * Entries are always replaced on insert, so the move comes from the last
+         * search of the state, which may be shallower than an earlier one.
          */
-        int get(uint64_t hash, int alpha, int beta);
+        int get(uint64_t hash, int alpha, int beta, int depth, uint64_t &move);
 };
 
 #endif
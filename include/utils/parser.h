@@ -20,13 +20,18 @@
 
 #include "app/app.h"
 #include "app/default_settings.h"
+#include <string>
 
 class Parser {
     private:
         App::Mode mode;
         UI::UIStyle style;
         Engine::Alg alg;
+        Engine::Eval eval;
         Engine::Settings settings;
+        Backend::Type backend;
+        std::string weights;
+        App::SelfPlay self_play;
 
         /// @brief Prints help message to terminal.
         void print_help() const;
@@ -40,15 +45,54 @@ class Parser {
         /// @brief Tries to parse engine.
         bool parse_engine(int argc, char **argv, int &i);
 
+        /// @brief Tries to parse evaluator.
+        bool parse_eval(int argc, char **argv, int &i);
+
         /// @brief Tries to parse style.
         bool parse_style(int argc, char **argv, int &i);
 
         /// @brief Tries to parse thread count.
         bool parse_threads(int argc, char **argv, int &i);
 
+        /// @brief Tries to parse size of the leaf evaluation cache.
+        bool parse_eval_cache(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse depth from which moves are ordered fastest-first.
+        bool parse_fastest_first(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse depth from which internal iterative deepening is used.
+        bool parse_iid(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse depth reduction of internal iterative deepening.
+        bool parse_iid_reduction(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse depth from which late moves are reduced.
+        bool parse_lmr(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse number of moves searched to the full depth.
+        bool parse_lmr_moves(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse largest reduction of late moves.
+        bool parse_lmr_reduction(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse number of exactly scored moves.
+        bool parse_multipv(int argc, char **argv, int &i);
+
         /// @brief Tries to parse engine search order.
         bool parse_order(int argc, char **argv, int &i);
 
+        /// @brief Tries to parse board backend.
+        bool parse_backend(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse path to the pattern weights.
+        bool parse_weights(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse number of self-play games.
+        bool parse_games(int argc, char **argv, int &i);
+
+        /// @brief Tries to parse path of the recorded self-play positions.
+        bool parse_record(int argc, char **argv, int &i);
+
     public:
         Parser();
 
@@ -58,7 +102,14 @@ class Parser {
         App::Mode get_mode() const;
         UI::UIStyle get_style() const;
         Engine::Alg get_alg() const;
+        Engine::Eval get_eval() const;
         Engine::Settings get_settings() const;
+        Backend::Type get_backend() const;
+
+        /// @brief Returns path to the pattern weights, empty if the default evaluation is used.
+        const std::string &get_weights() const;
+
+        App::SelfPlay get_self_play() const;
 };
 
 #endif
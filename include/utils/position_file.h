@@ -0,0 +1,68 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#ifndef POSITION_FILE_H
+#define POSITION_FILE_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Positions recorded in self-play games, used to train pattern weights.
+ * 
+ * File starts with FILE_MAGIC and little-endian uint32_t version, every
+ * record is then the white and black bitmap (little-endian uint64_t)
+ * followed by the final disc differential of the game (int8_t).
+ */
+class PositionFile {
+    public:
+        /// @brief One recorded position.
+        struct Record {
+            /// @brief White bitmap.
+            uint64_t white;
+            /// @brief Black bitmap.
+            uint64_t black;
+            /// @brief White discs minus black discs at the end of the game.
+            int8_t disc_diff;
+        };
+
+        /// @brief Identification of the positions file.
+        static constexpr char FILE_MAGIC[4] = {'R', 'V', 'S', 'P'};
+
+        /// @brief Version of the positions file layout.
+        static constexpr uint32_t FILE_VERSION = 1;
+
+        /**
+         * @brief Writes records to a new file.
+         * 
+         * @param path Path to the file, existing file is overwritten.
+         * @param records Records to write.
+         * @return True if the file was written.
+         */
+        static bool write(const char *path, const std::vector<Record> &records);
+
+        /**
+         * @brief Reads all records of a file.
+         * 
+         * @param path Path to the file.
+         * @param records Read records are appended to the vector.
+         * @return True if the file was read.
+         */
+        static bool read(const char *path, std::vector<Record> &records);
+};
+
+#endif
@@ -16,13 +16,32 @@
 */
 
 #include "app/app.h"
+#include "app/kernel_benchmark.h"
+#include "board/backend.h"
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include "board/pattern_eval.h"
+#include "utils/position_file.h"
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
 
-App::App(Mode mode, UI *ui, Engine *engine) : mode(mode), ui(ui), engine(engine) {}
+App::App(Mode mode, UI *ui, Engine *engine, Engine *reference, SelfPlay self_play) : mode(mode), ui(ui), engine(engine), reference(reference), self_play(self_play) {}
 
 void App::run() {
     if (mode == Mode::PLAY) {run_play();}
     else if (mode == Mode::BOT_VS_BOT) run_bot_vs_bot();
     else if (mode == Mode::BENCHMARK) run_benchmark();
+    else if (mode == Mode::KERNEL_BENCHMARK) run_kernel_benchmark();
+    else if (mode == Mode::VERIFY_EVAL) run_verify_eval();
+    else if (mode == Mode::SELF_PLAY) run_self_play();
+    else if (mode == Mode::SUITE) run_suite();
 }
 
 void App::run_play() {
@@ -31,6 +50,7 @@ void App::run_play() {
     
     bool at_turn = false;
     bool last_moved = true;
+    std::string reply_time;
 
     ui->display_game(last_board, current_board, at_turn);
     while (true) {
@@ -47,6 +67,12 @@ void App::run_play() {
         last_moved = true;
         if (at_turn) {
             ui->display_game(last_board, current_board, at_turn);
+            if (!reply_time.empty()) ui->display_message(reply_time);
+            // engine searches on the time of the player
+            Board ponder_board = current_board;
+            std::thread pondering([this, ponder_board, at_turn]() {
+                engine->ponder(ponder_board, at_turn);
+            });
             uint64_t move;
             while (true) {
                 UI::UserInput input = ui->get_input();
@@ -57,13 +83,20 @@ void App::run_play() {
                 ui->display_game(last_board, current_board, at_turn);
                 ui->display_message("INVALID");
             }
+            engine->stop_ponder();
+            pondering.join();
             last_board = current_board;
             current_board.play_move(at_turn, move);
         }
         else {
             uint64_t move = 0;
             ui->display_message("Thinking...");
+            auto start = std::chrono::steady_clock::now();
             move = engine->search(current_board, at_turn);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            std::ostringstream message;
+            message << "Engine replied in " << std::fixed << std::setprecision(1) << elapsed.count() << " ms";
+            reply_time = message.str();
             last_board = current_board;
             current_board.play_move(at_turn, move);
         }
@@ -98,3 +131,263 @@ void App::run_benchmark() {
     move = engine->search(init_board, false);
     ui->display_board(init_board, move);
 }
+
+// selects random move of the set, raw generator output keeps results same on all standard libraries
+static uint64_t random_move(uint64_t moves, std::mt19937 &generator) {
+    for (int skip = generator() % std::popcount(moves); skip > 0; --skip) {
+        moves &= moves - 1;
+    }
+    return moves & -moves;
+}
+
+std::vector<Board> App::random_positions(int count, unsigned int seed) {
+    // raw mt19937 output is used instead of distributions, those differ between standard libraries
+    std::mt19937 generator(seed);
+    std::vector<Board> positions;
+    positions.reserve(count);
+    while (static_cast<int>(positions.size()) < count) {
+        Board board = Board::States::INITIAL;
+        bool color = false;
+        int plies = 4 + generator() % 53;
+        for (int i = 0; i < plies; ++i) {
+            uint64_t moves = board.find_moves(color);
+            if (moves == 0) {
+                // pass, or the game is over
+                color = !color;
+                moves = board.find_moves(color);
+                if (moves == 0) break;
+            }
+            board.play_move(color, random_move(moves, generator));
+            color = !color;
+        }
+        // finished games are skipped, kernels expect a legal move to exist
+        if (board.find_moves(true) | board.find_moves(false)) {
+            positions.push_back(board);
+        }
+    }
+    return positions;
+}
+
+std::vector<KernelSample> App::kernel_samples(int count) {
+    std::vector<Board> positions = random_positions(count, 42);
+
+    // precompute one legal move for every state, so play_move always does real work
+    std::vector<KernelSample> samples(count);
+    for (int i = 0; i < count; ++i) {
+        bool color = i % 2;
+        uint64_t possible_moves = positions[i].find_moves(color);
+        if (possible_moves == 0) {
+            color = !color;
+            possible_moves = positions[i].find_moves(color);
+        }
+        samples[i] = {positions[i], color, possible_moves & -possible_moves};
+    }
+    return samples;
+}
+
+void App::run_kernel_benchmark() {
+    constexpr int POSITION_COUNT = 4096;
+    constexpr int ROUNDS = 256;
+    // frontier features are added to every leaf of the pattern evaluator,
+    // they may cost at most this fraction of find_moves_both
+    constexpr double FRONTIER_BUDGET = 0.5;
+    std::vector<KernelSample> samples = kernel_samples(POSITION_COUNT);
+
+    // every backend supported by the cpu is measured, all of them have to produce the same checksum
+    ui->display_message("backend  find_moves x2  find_moves_both  stable  frontier  play_move  rate_board  bitplane  pattern  children  batch  [ns]");
+    uint64_t reference = 0;
+    bool valid = true;
+    std::string over_budget;
+    auto report = [&](Backend::Type backend, KernelTimes times) {
+        if (backend == Backend::Type::NOSIMD) reference = times.checksum;
+        else if (times.checksum != reference) valid = false;
+        if (times.frontier > FRONTIER_BUDGET * times.find_moves_both) over_budget += std::string(" ") + Backend::name(backend);
+        auto format = [](double value, int width) {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(1) << std::left << std::setw(width);
+            // kernels which were not measured have zero time
+            if (value > 0) out << value;
+            else out << '-';
+            return out.str();
+        };
+        std::string name = Backend::name(backend);
+        name.resize(9, ' ');
+        ui->display_message(name + format(times.find_moves, 15) + format(times.find_moves_both, 17) + format(times.stable, 8) + format(times.frontier, 10) + format(times.play_move, 11) + format(times.rate_board, 12) + format(times.bitplane, 10) + format(times.pattern, 9) + format(times.children, 10) + format(times.batch, 0));
+    };
+
+    report(Backend::Type::NOSIMD, KernelBenchmark<Board>::run(samples.data(), POSITION_COUNT, ROUNDS));
+#ifdef REVERSAN_SSE
+    if (Backend::available(Backend::Type::SSE)) {
+        report(Backend::Type::SSE, KernelBenchmark<BoardSSE>::run(samples.data(), POSITION_COUNT, ROUNDS));
+    }
+#endif
+#ifdef REVERSAN_AVX2
+    if (Backend::available(Backend::Type::AVX2)) {
+        report(Backend::Type::AVX2, KernelBenchmark<BoardAVX2>::run(samples.data(), POSITION_COUNT, ROUNDS));
+    }
+#endif
+#ifdef REVERSAN_AVX512
+    if (Backend::available(Backend::Type::AVX512)) {
+        report(Backend::Type::AVX512, KernelBenchmark<BoardAVX512>::run(samples.data(), POSITION_COUNT, ROUNDS));
+    }
+#endif
+#ifdef REVERSAN_BMI2
+    if (Backend::available(Backend::Type::BMI2)) {
+        report(Backend::Type::BMI2, KernelBenchmark<BoardBMI2>::run(samples.data(), POSITION_COUNT, ROUNDS));
+    }
+#endif
+    ui->display_message("checksum " + std::to_string(reference) + (valid ? " (all backends match)" : " (BACKENDS DIFFER)"));
+    if (over_budget.empty()) ui->display_message("frontier within budget (at most half of find_moves_both)");
+    else ui->display_message("FRONTIER OVER BUDGET on" + over_budget);
+}
+
+void App::run_verify_eval() {
+    constexpr int POSITION_COUNT = 65536;
+    std::vector<KernelSample> samples = kernel_samples(POSITION_COUNT);
+
+    // incremental evaluation of every backend supported by the cpu is checked
+    bool valid = true;
+    auto report = [&](Backend::Type backend, uint64_t mismatches, uint64_t checked) {
+        if (mismatches != 0) valid = false;
+        std::string name = Backend::name(backend);
+        name.resize(9, ' ');
+        ui->display_message(name + std::to_string(checked) + " checks, " + std::to_string(mismatches) + " mismatches");
+    };
+
+    uint64_t checked = 0;
+    uint64_t mismatches = KernelBenchmark<Board>::verify(samples.data(), POSITION_COUNT, checked);
+    report(Backend::Type::NOSIMD, mismatches, checked);
+#ifdef REVERSAN_SSE
+    if (Backend::available(Backend::Type::SSE)) {
+        checked = 0;
+        mismatches = KernelBenchmark<BoardSSE>::verify(samples.data(), POSITION_COUNT, checked);
+        report(Backend::Type::SSE, mismatches, checked);
+    }
+#endif
+#ifdef REVERSAN_AVX2
+    if (Backend::available(Backend::Type::AVX2)) {
+        checked = 0;
+        mismatches = KernelBenchmark<BoardAVX2>::verify(samples.data(), POSITION_COUNT, checked);
+        report(Backend::Type::AVX2, mismatches, checked);
+    }
+#endif
+#ifdef REVERSAN_AVX512
+    if (Backend::available(Backend::Type::AVX512)) {
+        checked = 0;
+        mismatches = KernelBenchmark<BoardAVX512>::verify(samples.data(), POSITION_COUNT, checked);
+        report(Backend::Type::AVX512, mismatches, checked);
+    }
+#endif
+#ifdef REVERSAN_BMI2
+    if (Backend::available(Backend::Type::BMI2)) {
+        checked = 0;
+        mismatches = KernelBenchmark<BoardBMI2>::verify(samples.data(), POSITION_COUNT, checked);
+        report(Backend::Type::BMI2, mismatches, checked);
+    }
+#endif
+    if (valid) {
+        ui->display_message("incremental and bit-plane evaluation match rate_board()");
+        ui->display_message("stable discs match portable kernel and survive every move");
+        ui->display_message("frontier discs and potential moves match portable kernel");
+        if (PatternEval::weights()) ui->display_message("pattern evaluation matches reference");
+    }
+    else {
+        ui->display_message("EVALUATION DIFFERS");
+    }
+}
+
+void App::run_self_play() {
+    // first moves are random, otherwise the deterministic engine would play the same game
+    constexpr int RANDOM_PLIES = 10;
+    std::mt19937 generator(1);
+    std::vector<PositionFile::Record> records;
+
+    for (int game = 0; game < self_play.games; ++game) {
+        Board board = Board::States::INITIAL;
+        bool color = false;
+        std::vector<Board> searched;
+        for (int ply = 0; ; ++ply) {
+            uint64_t moves = board.find_moves(color);
+            if (moves == 0) {
+                // pass, or the game is over
+                color = !color;
+                moves = board.find_moves(color);
+                if (moves == 0) break;
+            }
+            uint64_t move;
+            if (ply < RANDOM_PLIES) {
+                move = random_move(moves, generator);
+            }
+            else {
+                searched.push_back(board);
+                move = engine->search(board, color);
+            }
+            board.play_move(color, move);
+            color = !color;
+        }
+
+        int disc_diff = board.count_white() - board.count_black();
+        for (const Board &position : searched) {
+            records.push_back({position.white(), position.black(), static_cast<int8_t>(disc_diff)});
+        }
+        if ((game + 1) % 100 == 0 || game + 1 == self_play.games) {
+            ui->display_message("played " + std::to_string(game + 1) + " games, recorded " + std::to_string(records.size()) + " positions");
+        }
+    }
+
+    if (PositionFile::write(self_play.path, records)) {
+        ui->display_message(std::string("positions written to ") + self_play.path);
+    }
+}
+
+void App::run_suite() {
+    constexpr int POSITION_COUNT = 32;
+    std::vector<Board> positions = random_positions(POSITION_COUNT, 7);
+
+    std::string header = "position  empties  states      time [ms]";
+    if (reference) header += "  full states  full time [ms]  move";
+    ui->display_message(header);
+    unsigned long long int total_states = 0;
+    unsigned long long int total_reference_states = 0;
+    double total_time = 0;
+    double total_reference_time = 0;
+    int agreed = 0;
+    for (int i = 0; i < POSITION_COUNT; ++i) {
+        const Board &position = positions[i];
+        int empties = 64 - std::popcount(position.white() | position.black());
+        // without passes black is at turn with even number of empty squares
+        bool color = empties % 2 != 0;
+        if (position.find_moves(color) == 0) color = !color;
+
+        auto start = std::chrono::steady_clock::now();
+        uint64_t move = engine->search(position, color);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        unsigned long long int states = engine->get_last_stats().state_count;
+        total_states += states;
+        total_time += elapsed.count();
+
+        std::ostringstream line;
+        line << std::left << std::setw(10) << i << std::setw(9) << empties << std::setw(12) << states
+             << std::fixed << std::setprecision(1) << std::setw(reference ? 11 : 0) << elapsed.count();
+        if (reference) {
+            start = std::chrono::steady_clock::now();
+            uint64_t reference_move = reference->search(position, color);
+            elapsed = std::chrono::steady_clock::now() - start;
+            unsigned long long int reference_states = reference->get_last_stats().state_count;
+            total_reference_states += reference_states;
+            total_reference_time += elapsed.count();
+            agreed += move == reference_move;
+            line << "  " << std::setw(13) << reference_states << std::setw(16) << elapsed.count()
+                 << (move == reference_move ? "same" : "DIFFERS");
+        }
+        ui->display_message(line.str());
+    }
+
+    std::ostringstream total;
+    total << "total             " << std::left << std::setw(12) << total_states << std::fixed << std::setprecision(1) << std::setw(reference ? 11 : 0) << total_time;
+    if (reference) {
+        total << "  " << std::setw(13) << total_reference_states << std::setw(16) << total_reference_time
+              << agreed << "/" << POSITION_COUNT << " agree";
+    }
+    ui->display_message(total.str());
+}
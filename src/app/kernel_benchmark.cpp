@@ -0,0 +1,182 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "app/kernel_benchmark.h"
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include "board/bitplane_board.h"
+#include "board/incremental_board.h"
+#include "board/pattern_board.h"
+#include "board/pattern_eval.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+// runs the kernel over all samples in multiple rounds and returns time of the fastest one
+// in nanoseconds per call, the fastest round is the least affected by other processes
+template <class Kernel>
+static double measure(int count, int rounds, uint64_t &checksum, Kernel kernel) {
+    double best = 0;
+    for (int round = 0; round < rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i) {
+            checksum += kernel(i);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        if (round == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+    return best / count;
+}
+
+template <class BoardT>
+KernelTimes KernelBenchmark<BoardT>::run(const KernelSample *samples, int count, int rounds) {
+    KernelTimes times;
+    // checksum keeps the compiler from optimizing measured calls away
+    times.checksum = 0;
+
+    times.find_moves = measure(count, rounds, times.checksum, [&](int i) {
+        BoardT state(samples[i].state);
+        return state.find_moves(true) ^ state.find_moves(false);
+    });
+    times.find_moves_both = measure(count, rounds, times.checksum, [&](int i) {
+        BoardT state(samples[i].state);
+        uint64_t white_moves, black_moves;
+        state.find_moves_both(white_moves, black_moves);
+        return white_moves ^ black_moves;
+    });
+    times.stable = measure(count, rounds, times.checksum, [&](int i) {
+        BoardT state(samples[i].state);
+        uint64_t white_stable, black_stable;
+        state.find_stable(white_stable, black_stable);
+        return white_stable ^ black_stable;
+    });
+    times.frontier = measure(count, rounds, times.checksum, [&](int i) {
+        BoardT state(samples[i].state);
+        uint64_t white_frontier, black_frontier, white_potential, black_potential;
+        state.find_frontier(white_frontier, black_frontier, white_potential, black_potential);
+        return white_frontier ^ black_frontier ^ (white_potential + black_potential);
+    });
+    times.play_move = measure(count, rounds, times.checksum, [&](int i) {
+        BoardT next(samples[i].state);
+        next.play_move(samples[i].color, samples[i].move);
+        return next.white() ^ next.black();
+    });
+    times.rate_board = measure(count, rounds, times.checksum, [&](int i) {
+        BoardT state(samples[i].state);
+        return static_cast<uint64_t>(state.rate_board());
+    });
+    times.bitplane = measure(count, rounds, times.checksum, [&](int i) {
+        BitplaneBoard<BoardT> state(samples[i].state);
+        return static_cast<uint64_t>(state.rate_board());
+    });
+
+    // pattern evaluator is measured only with loaded weights
+    times.pattern = 0;
+    if (PatternEval::weights()) {
+        times.pattern = measure(count, rounds, times.checksum, [&](int i) {
+            PatternBoard<BoardT> state(samples[i].state);
+            return static_cast<uint64_t>(state.rate_board());
+        });
+    }
+
+    // leaf kernels are reported per rated child, not per sample
+    uint64_t children = 0;
+    for (int i = 0; i < count; ++i) {
+        children += std::popcount(samples[i].state.find_moves(samples[i].color));
+    }
+    double per_child = static_cast<double>(count) / children;
+    times.children = per_child * measure(count, rounds, times.checksum, [&](int i) {
+        IncrementalBoard<BoardT> state(samples[i].state);
+        bool color = samples[i].color;
+        uint64_t possible_moves = state.find_moves(color);
+        int best = color ? -1000 : 1000;
+        while (possible_moves) {
+            uint64_t move = possible_moves & -possible_moves;
+            possible_moves ^= move;
+            uint64_t flips = state.flips(color, move);
+            state.apply_move(color, move, flips);
+            best = color ? std::max(best, state.rate_board()) : std::min(best, state.rate_board());
+            state.undo_move(color, move, flips);
+        }
+        return static_cast<uint64_t>(best);
+    });
+    times.batch = per_child * measure(count, rounds, times.checksum, [&](int i) {
+        IncrementalBoard<BoardT> state(samples[i].state);
+        bool color = samples[i].color;
+        return static_cast<uint64_t>(state.rate_children(color, state.find_moves(color)));
+    });
+    return times;
+}
+
+template <class BoardT>
+uint64_t KernelBenchmark<BoardT>::verify(const KernelSample *samples, int count, uint64_t &checked) {
+    uint64_t mismatches = 0;
+    for (int i = 0; i < count; ++i) {
+        IncrementalBoard<BoardT> state(samples[i].state);
+        bool color = samples[i].color;
+        int score = BoardT(samples[i].state).rate_board();
+        mismatches += state.rate_board() != score;
+        mismatches += BitplaneBoard<BoardT>(samples[i].state).rate_board() != score;
+        uint64_t white_moves, black_moves;
+        state.find_moves_both(white_moves, black_moves);
+        mismatches += white_moves != state.find_moves(true) || black_moves != state.find_moves(false);
+        uint64_t white_stable, black_stable, white_expected, black_expected;
+        state.find_stable(white_stable, black_stable);
+        samples[i].state.find_stable(white_expected, black_expected);
+        mismatches += white_stable != white_expected || black_stable != black_expected;
+        uint64_t frontier[4], frontier_expected[4];
+        state.find_frontier(frontier[0], frontier[1], frontier[2], frontier[3]);
+        samples[i].state.find_frontier(frontier_expected[0], frontier_expected[1], frontier_expected[2], frontier_expected[3]);
+        mismatches += !std::equal(frontier, frontier + 4, frontier_expected);
+        checked += 5;
+        if (PatternEval::weights()) {
+            PatternBoard<BoardT> patterns(samples[i].state);
+            mismatches += patterns.rate_board() != PatternEval::reference(patterns.white(), patterns.black());
+            checked++;
+        }
+
+        int best = color ? -1000 : 1000;
+        uint64_t possible_moves = state.find_moves(color);
+        while (possible_moves) {
+            uint64_t move = possible_moves & -possible_moves;
+            possible_moves ^= move;
+
+            uint64_t flips = state.flips(color, move);
+            state.apply_move(color, move, flips);
+            BoardT full(Board(state.white(), state.black()));
+            int child_score = full.rate_board();
+            mismatches += state.rate_board() != child_score;
+            // no move can flip a stable disc
+            mismatches += (white_stable & ~state.white()) != 0 || (black_stable & ~state.black()) != 0;
+            state.undo_move(color, move, flips);
+            // undo has to restore both the pieces and the score
+            bool restored = state.white() == samples[i].state.white() && state.black() == samples[i].state.black();
+            mismatches += !restored || state.rate_board() != score;
+            checked += 3;
+            best = color ? std::max(best, child_score) : std::min(best, child_score);
+        }
+        // samples always have a legal move, batched evaluation has to pick the same child score
+        mismatches += state.rate_children(color, state.find_moves(color)) != best;
+        checked++;
+    }
+    return mismatches;
+}
+
+// benchmark is compiled once for every board backend, see CMakeLists.txt
+template class KernelBenchmark<BOARD_BACKEND>;
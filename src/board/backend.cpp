@@ -0,0 +1,179 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "board/backend.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+// backends enabled at build time, see CMakeLists.txt
+#ifdef REVERSAN_AVX2
+    static constexpr bool BUILT_AVX2 = true;
+#else
+    static constexpr bool BUILT_AVX2 = false;
+#endif
+
+#ifdef REVERSAN_AVX512
+    static constexpr bool BUILT_AVX512 = true;
+#else
+    static constexpr bool BUILT_AVX512 = false;
+#endif
+
+#ifdef REVERSAN_BMI2
+    static constexpr bool BUILT_BMI2 = true;
+#else
+    static constexpr bool BUILT_BMI2 = false;
+#endif
+
+#ifdef REVERSAN_SSE
+    static constexpr bool BUILT_SSE = true;
+#else
+    static constexpr bool BUILT_SSE = false;
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+
+// compiler runtime checks both cpuid and whether the OS saves the vector registers
+static bool cpu_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+
+static bool cpu_avx512() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("popcnt");
+}
+
+// BMI2 backend also uses AVX2 kernels
+static bool cpu_bmi2() {
+    __builtin_cpu_init();
+    return cpu_avx2() && __builtin_cpu_supports("bmi2");
+}
+
+static bool cpu_sse() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("popcnt");
+}
+
+// pext and pdep are microcoded on AMD before Zen 3, taking up to hundreds of cycles
+static bool cpu_slow_pext() {
+    __builtin_cpu_init();
+    return __builtin_cpu_is("amdfam15h") || __builtin_cpu_is("amdfam17h");
+}
+
+#elif defined(_MSC_VER)
+
+// checks that the OS saves all registers in the mask on context switch
+static bool os_saves(unsigned long long mask) {
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = info[2] & (1 << 27);
+    return osxsave && (_xgetbv(0) & mask) == mask;
+}
+
+static bool cpu_avx2() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool popcnt = info[2] & (1 << 23);
+    __cpuidex(info, 7, 0);
+    bool avx2 = info[1] & (1 << 5);
+    // XMM and YMM state
+    return popcnt && avx2 && os_saves(0x6);
+}
+
+static bool cpu_avx512() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool popcnt = info[2] & (1 << 23);
+    __cpuidex(info, 7, 0);
+    bool avx512f = info[1] & (1 << 16);
+    bool avx512bw = info[1] & (1 << 30);
+    // XMM, YMM, opmask and ZMM state
+    return popcnt && avx512f && avx512bw && os_saves(0xe6);
+}
+
+// BMI2 backend also uses AVX2 kernels
+static bool cpu_bmi2() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    bool bmi2 = info[1] & (1 << 8);
+    return bmi2 && cpu_avx2();
+}
+
+// SSE state is always saved by 64bit operating systems
+static bool cpu_sse() {
+    int info[4];
+    __cpuid(info, 1);
+    bool ssse3 = info[2] & (1 << 9);
+    bool popcnt = info[2] & (1 << 23);
+    return ssse3 && popcnt;
+}
+
+// pext and pdep are microcoded on AMD before Zen 3, taking up to hundreds of cycles
+static bool cpu_slow_pext() {
+    int info[4];
+    __cpuid(info, 0);
+    // vendor string "AuthenticAMD" is stored in ebx, edx, ecx
+    bool amd = info[1] == 0x68747541 && info[3] == 0x69746e65 && info[2] == 0x444d4163;
+    __cpuid(info, 1);
+    int family = (info[0] >> 8) & 0xf;
+    if (family == 0xf) family += (info[0] >> 20) & 0xff;
+    return amd && family < 0x19;
+}
+
+#else
+
+static bool cpu_avx2() {return false;}
+static bool cpu_avx512() {return false;}
+static bool cpu_bmi2() {return false;}
+static bool cpu_sse() {return false;}
+static bool cpu_slow_pext() {return true;}
+
+#endif
+
+Backend::Type Backend::detect() {
+    if (available(Type::AVX512)) return Type::AVX512;
+    if (available(Type::BMI2) && !cpu_slow_pext()) return Type::BMI2;
+    if (available(Type::AVX2)) return Type::AVX2;
+    if (available(Type::SSE)) return Type::SSE;
+    return Type::NOSIMD;
+}
+
+bool Backend::available(Type type) {
+    if (type == Type::NOSIMD) return true;
+    if (type == Type::AVX2) return BUILT_AVX2 && cpu_avx2();
+    if (type == Type::AVX512) return BUILT_AVX512 && cpu_avx512();
+    if (type == Type::BMI2) return BUILT_BMI2 && cpu_bmi2();
+    if (type == Type::SSE) return BUILT_SSE && cpu_sse();
+    return false;
+}
+
+const char *Backend::name(Type type) {
+    if (type == Type::NOSIMD) return "nosimd";
+    if (type == Type::AVX2) return "avx2";
+    if (type == Type::AVX512) return "avx512";
+    if (type == Type::BMI2) return "bmi2";
+    if (type == Type::SSE) return "sse";
+    return "auto";
+}
@@ -0,0 +1,85 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "board/bitplane_board.h"
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include <bit>
+
+// heuristics map split into bit-planes of weight magnitudes,
+// squares with positive and negative weights are kept in separate planes
+struct WeightPlanes {
+    static constexpr int MAX_LEVELS = 8;
+    uint64_t positive[MAX_LEVELS];
+    uint64_t negative[MAX_LEVELS];
+    int levels;
+};
+
+static constexpr WeightPlanes generate_planes() {
+    WeightPlanes planes = {};
+    for (int i = 0; i < 64; ++i) {
+        int weight = Board::heuristics_map[63 - i];
+        int magnitude = weight < 0 ? -weight : weight;
+        for (int k = 0; k < WeightPlanes::MAX_LEVELS; ++k) {
+            if ((magnitude >> k) & 1) {
+                if (weight > 0) planes.positive[k] |= static_cast<uint64_t>(1) << i;
+                else planes.negative[k] |= static_cast<uint64_t>(1) << i;
+                if (k + 1 > planes.levels) planes.levels = k + 1;
+            }
+        }
+    }
+    return planes;
+}
+
+static constexpr WeightPlanes weight_planes = generate_planes();
+
+template <class BoardT>
+ALWAYS_INLINE int BitplaneBoard<BoardT>::position_score() const {
+    uint64_t white = this->white_bitmap;
+    uint64_t black = this->black_bitmap;
+    int score = 0;
+    // white and black never overlap and neither do positive and negative planes, so every level
+    // takes only two popcounts, squares adding to the score and squares subtracting from it
+    for (int k = 0; k < weight_planes.levels; ++k) {
+        uint64_t adding = (white & weight_planes.positive[k]) | (black & weight_planes.negative[k]);
+        uint64_t subtracting = (black & weight_planes.positive[k]) | (white & weight_planes.negative[k]);
+        score += (std::popcount(adding) - std::popcount(subtracting)) << k;
+    }
+    return score;
+}
+
+template <class BoardT>
+ALWAYS_INLINE int BitplaneBoard<BoardT>::rate_board() const {
+    uint64_t white_moves, black_moves;
+    this->find_moves_both(white_moves, black_moves);
+    int moves_delta = std::popcount(white_moves) - std::popcount(black_moves);
+    return position_score() + 10 * moves_delta;
+}
+
+// evaluator is compiled once for every board backend, see CMakeLists.txt
+template class BitplaneBoard<BOARD_BACKEND>;
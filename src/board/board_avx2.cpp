@@ -24,7 +24,7 @@
     #define ALWAYS_INLINE
 #endif
 
-#include "board/board.h"
+#include "board/board_avx2.h"
 #include <immintrin.h>
 #include <bit>
 
@@ -42,7 +42,7 @@ static constexpr uint64_t heur_map1[4] = {convert_col(7), convert_col(6), conver
 static constexpr uint64_t heur_map2[4] = {convert_col(3), convert_col(2), convert_col(1), convert_col(0)};
 
 
-ALWAYS_INLINE int Board::rate_board() const {
+ALWAYS_INLINE int BoardAVX2::rate_board() const {
     int score = 0;
     
     // the goal is to manipulate the bitmap to get 256bit vector containing
@@ -104,12 +104,14 @@ ALWAYS_INLINE int Board::rate_board() const {
         score += static_cast<int>(int_result[i]);
     }
     
-    int moves_delta = std::popcount(find_moves(true)) - std::popcount(find_moves(false));
+    uint64_t white_moves, black_moves;
+    find_moves_both(white_moves, black_moves);
+    int moves_delta = std::popcount(white_moves) - std::popcount(black_moves);
     score += 10 * moves_delta;
     return score;
 }
 
-ALWAYS_INLINE uint64_t Board::find_moves(bool color) const {
+ALWAYS_INLINE uint64_t BoardAVX2::find_moves(bool color) const {
     uint64_t valid_moves = 0;
     // create new bitmap of empty spaces from our two bitmaps so we do not have to check both for empty spaces
     uint64_t free_spaces = ~(white_bitmap | black_bitmap);
@@ -183,7 +185,172 @@ ALWAYS_INLINE uint64_t Board::find_moves(bool color) const {
     return valid_moves;
 }
 
-ALWAYS_INLINE void Board::play_move(bool color, uint64_t move) {
+// Kogge-Stone occluded fill of 4 directions at once, left shifting directions are
+// selected by the template argument, right shifting directions use the same shift values
+template <bool left>
+static ALWAYS_INLINE __m256i shift_dirs(__m256i vec, __m256i shift_vals_vec) {
+    if constexpr (left) return _mm256_sllv_epi64(vec, shift_vals_vec);
+    else return _mm256_srlv_epi64(vec, shift_vals_vec);
+}
+
+template <bool left>
+static ALWAYS_INLINE __m256i moves_dirs(__m256i playing_vec, __m256i opponent_adjusted_vec, __m256i shift_vals_vec) {
+    __m256i gen_vec = playing_vec;
+    __m256i pro_vec = opponent_adjusted_vec;
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_dirs<left>(gen_vec, shift_vals_vec)));
+    pro_vec = _mm256_and_si256(pro_vec, shift_dirs<left>(pro_vec, shift_vals_vec));
+    __m256i double_vals_vec = _mm256_add_epi64(shift_vals_vec, shift_vals_vec);
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_dirs<left>(gen_vec, double_vals_vec)));
+    pro_vec = _mm256_and_si256(pro_vec, shift_dirs<left>(pro_vec, double_vals_vec));
+    __m256i quad_vals_vec = _mm256_add_epi64(double_vals_vec, double_vals_vec);
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_dirs<left>(gen_vec, quad_vals_vec)));
+    // only opponent pieces are taken from the fill, moves are right behind them
+    return shift_dirs<left>(_mm256_and_si256(gen_vec, opponent_adjusted_vec), shift_vals_vec);
+}
+
+ALWAYS_INLINE void BoardAVX2::find_moves_both(uint64_t &white_moves, uint64_t &black_moves) const {
+    uint64_t free_spaces = ~(white_bitmap | black_bitmap);
+
+    // unlike find_moves, left and right directions are filled separately with Kogge-Stone fills,
+    // which takes 3 steps instead of 7, the 4 resulting dependency chains are independent
+    __m256i shift_vals_vec = _mm256_set_epi64x(9, 8, 7, 1);
+    __m256i col_mask_vec = _mm256_set_epi64x(Masks::SIDE_COLS_MASK, Masks::NO_COL_MASK, Masks::SIDE_COLS_MASK, Masks::SIDE_COLS_MASK);
+    __m256i white_vec = _mm256_set1_epi64x(white_bitmap);
+    __m256i black_vec = _mm256_set1_epi64x(black_bitmap);
+    __m256i white_adjusted_vec = _mm256_and_si256(white_vec, col_mask_vec);
+    __m256i black_adjusted_vec = _mm256_and_si256(black_vec, col_mask_vec);
+
+    __m256i white_moves_vec = _mm256_or_si256(moves_dirs<true>(white_vec, black_adjusted_vec, shift_vals_vec),
+                                              moves_dirs<false>(white_vec, black_adjusted_vec, shift_vals_vec));
+    __m256i black_moves_vec = _mm256_or_si256(moves_dirs<true>(black_vec, white_adjusted_vec, shift_vals_vec),
+                                              moves_dirs<false>(black_vec, white_adjusted_vec, shift_vals_vec));
+
+    // both reductions share the shuffles, white ends in lane 0 and black in lane 1
+    __m256i joined_vec = _mm256_or_si256(_mm256_unpacklo_epi64(white_moves_vec, black_moves_vec), _mm256_unpackhi_epi64(white_moves_vec, black_moves_vec));
+    __m128i half_vec = _mm_or_si128(_mm256_castsi256_si128(joined_vec), _mm256_extracti128_si256(joined_vec, 1));
+    white_moves = static_cast<uint64_t>(_mm_cvtsi128_si64(half_vec)) & free_spaces;
+    black_moves = static_cast<uint64_t>(_mm_extract_epi64(half_vec, 1)) & free_spaces;
+}
+
+// Kogge-Stone occluded fill of 4 directions at once
+template <bool left>
+static ALWAYS_INLINE __m256i fill_dirs(__m256i gen_vec, __m256i pro_vec, __m256i shift_vals_vec) {
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_dirs<left>(gen_vec, shift_vals_vec)));
+    pro_vec = _mm256_and_si256(pro_vec, shift_dirs<left>(pro_vec, shift_vals_vec));
+    __m256i double_vals_vec = _mm256_add_epi64(shift_vals_vec, shift_vals_vec);
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_dirs<left>(gen_vec, double_vals_vec)));
+    pro_vec = _mm256_and_si256(pro_vec, shift_dirs<left>(pro_vec, double_vals_vec));
+    __m256i quad_vals_vec = _mm256_add_epi64(double_vals_vec, double_vals_vec);
+    return _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_dirs<left>(gen_vec, quad_vals_vec)));
+}
+
+// and of all 4 lanes, result is in every lane
+static ALWAYS_INLINE __m256i and_lanes(__m256i vec) {
+    vec = _mm256_and_si256(vec, _mm256_permute4x64_epi64(vec, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm256_and_si256(vec, _mm256_permute4x64_epi64(vec, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+// stable discs of one color, which are safe in all 4 directions
+static ALWAYS_INLINE __m256i stable_dirs(__m256i own_vec, __m256i stable_vec, __m256i fixed_vec, __m256i shift_vals_vec,
+                                         __m256i mask_left_vec, __m256i mask_right_vec) {
+    __m256i left_vec = _mm256_and_si256(_mm256_sllv_epi64(stable_vec, shift_vals_vec), mask_left_vec);
+    __m256i right_vec = _mm256_and_si256(_mm256_srlv_epi64(stable_vec, shift_vals_vec), mask_right_vec);
+    __m256i safe_vec = _mm256_or_si256(fixed_vec, _mm256_or_si256(left_vec, right_vec));
+    return _mm256_and_si256(own_vec, and_lanes(safe_vec));
+}
+
+ALWAYS_INLINE void BoardAVX2::find_stable(uint64_t &white_stable, uint64_t &black_stable) const {
+    constexpr int64_t LEFT = static_cast<int64_t>(Masks::LEFT_COL_MASK);
+    constexpr int64_t RIGHT = static_cast<int64_t>(Masks::RIGHT_COL_MASK);
+    constexpr int64_t EDGE = static_cast<int64_t>(Masks::EDGE_MASK);
+
+    // lanes hold the 4 directions in the same order as in find_moves
+    __m256i shift_vals_vec = _mm256_set_epi64x(9, 8, 7, 1);
+    __m256i mask_left_vec = _mm256_set_epi64x(LEFT, -1, RIGHT, LEFT);
+    __m256i mask_right_vec = _mm256_set_epi64x(RIGHT, -1, LEFT, RIGHT);
+
+    // full lines, every direction is filled from both of its edges
+    __m256i occupied_vec = _mm256_set1_epi64x(white_bitmap | black_bitmap);
+    __m256i edge_left_vec = _mm256_set_epi64x(0x01010101010101ff, 0x00000000000000ff, static_cast<int64_t>(0x80808080808080ff), 0x0101010101010101);
+    __m256i edge_right_vec = _mm256_set_epi64x(static_cast<int64_t>(0xff80808080808080), static_cast<int64_t>(0xff00000000000000),
+                                               static_cast<int64_t>(0xff01010101010101), static_cast<int64_t>(0x8080808080808080));
+    __m256i fill_left_vec = fill_dirs<true>(_mm256_and_si256(occupied_vec, edge_left_vec), _mm256_and_si256(occupied_vec, mask_left_vec), shift_vals_vec);
+    __m256i fill_right_vec = fill_dirs<false>(_mm256_and_si256(occupied_vec, edge_right_vec), _mm256_and_si256(occupied_vec, mask_right_vec), shift_vals_vec);
+
+    // squares safe in the direction regardless of neighbours
+    __m256i edges_vec = _mm256_set_epi64x(EDGE, static_cast<int64_t>(0xff000000000000ff), EDGE, static_cast<int64_t>(0x8181818181818181));
+    __m256i fixed_vec = _mm256_or_si256(_mm256_and_si256(fill_left_vec, fill_right_vec), edges_vec);
+
+    // stable sets are kept in all lanes, so no extraction is needed until they stop growing
+    __m256i white_vec = _mm256_set1_epi64x(white_bitmap);
+    __m256i black_vec = _mm256_set1_epi64x(black_bitmap);
+    __m256i white_stable_vec = _mm256_setzero_si256();
+    __m256i black_stable_vec = _mm256_setzero_si256();
+    __m256i changed_vec;
+    do {
+        __m256i white_next_vec = stable_dirs(white_vec, white_stable_vec, fixed_vec, shift_vals_vec, mask_left_vec, mask_right_vec);
+        __m256i black_next_vec = stable_dirs(black_vec, black_stable_vec, fixed_vec, shift_vals_vec, mask_left_vec, mask_right_vec);
+        changed_vec = _mm256_or_si256(_mm256_xor_si256(white_next_vec, white_stable_vec), _mm256_xor_si256(black_next_vec, black_stable_vec));
+        white_stable_vec = white_next_vec;
+        black_stable_vec = black_next_vec;
+    } while (!_mm256_testz_si256(changed_vec, changed_vec));
+
+    white_stable = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(white_stable_vec)));
+    black_stable = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(black_stable_vec)));
+}
+
+// shifts all boards in the same direction, positive values shift left, negative right
+template <int dir>
+static ALWAYS_INLINE __m256i shift_boards(__m256i vec) {
+    if constexpr (dir > 0) return _mm256_slli_epi64(vec, dir);
+    else return _mm256_srli_epi64(vec, -dir);
+}
+
+// Kogge-Stone fill of one direction for every board in the vector
+template <int dir>
+static ALWAYS_INLINE __m256i moves_boards(__m256i playing_vec, __m256i opponent_adjusted_vec) {
+    __m256i gen_vec = playing_vec;
+    __m256i pro_vec = opponent_adjusted_vec;
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_boards<dir>(gen_vec)));
+    pro_vec = _mm256_and_si256(pro_vec, shift_boards<dir>(pro_vec));
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_boards<2*dir>(gen_vec)));
+    pro_vec = _mm256_and_si256(pro_vec, shift_boards<2*dir>(pro_vec));
+    gen_vec = _mm256_or_si256(gen_vec, _mm256_and_si256(pro_vec, shift_boards<4*dir>(gen_vec)));
+    return shift_boards<dir>(_mm256_and_si256(gen_vec, opponent_adjusted_vec));
+}
+
+// moves in all 8 directions for every board in the vector, empty squares are not masked
+static ALWAYS_INLINE __m256i all_moves_boards(__m256i playing_vec, __m256i opponent_vec) {
+    constexpr int64_t SIDE = static_cast<int64_t>(0x7e7e7e7e7e7e7e7e);
+    __m256i opponent_adjusted_vec = _mm256_and_si256(opponent_vec, _mm256_set1_epi64x(SIDE));
+    __m256i moves_vec = _mm256_or_si256(moves_boards<1>(playing_vec, opponent_adjusted_vec), moves_boards<-1>(playing_vec, opponent_adjusted_vec));
+    moves_vec = _mm256_or_si256(moves_vec, _mm256_or_si256(moves_boards<7>(playing_vec, opponent_adjusted_vec), moves_boards<-7>(playing_vec, opponent_adjusted_vec)));
+    moves_vec = _mm256_or_si256(moves_vec, _mm256_or_si256(moves_boards<8>(playing_vec, opponent_vec), moves_boards<-8>(playing_vec, opponent_vec)));
+    moves_vec = _mm256_or_si256(moves_vec, _mm256_or_si256(moves_boards<9>(playing_vec, opponent_adjusted_vec), moves_boards<-9>(playing_vec, opponent_adjusted_vec)));
+    return moves_vec;
+}
+
+ALWAYS_INLINE void BoardAVX2::mobility_batch(const uint64_t *whites, const uint64_t *blacks, int count, int *moves_delta) {
+    // every lane holds one board, so all lanes shift in the same direction
+    // and immediate shifts can be used instead of variable ones
+    for (int i = 0; i < count; i += 4) {
+        __m256i white_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(whites + i));
+        __m256i black_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blacks + i));
+        __m256i occupied_vec = _mm256_or_si256(white_vec, black_vec);
+        __m256i white_moves_vec = _mm256_andnot_si256(occupied_vec, all_moves_boards(white_vec, black_vec));
+        __m256i black_moves_vec = _mm256_andnot_si256(occupied_vec, all_moves_boards(black_vec, white_vec));
+
+        alignas(32) uint64_t white_moves[4];
+        alignas(32) uint64_t black_moves[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(white_moves), white_moves_vec);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(black_moves), black_moves_vec);
+        for (int j = 0; j < 4; ++j) {
+            moves_delta[i + j] = std::popcount(white_moves[j]) - std::popcount(black_moves[j]);
+        }
+    }
+}
+
+ALWAYS_INLINE uint64_t BoardAVX2::flips(bool color, uint64_t move) const {
     uint64_t playing, opponent;
     if (color) {
         playing = white_bitmap;
@@ -238,24 +405,35 @@ ALWAYS_INLINE void Board::play_move(bool color, uint64_t move) {
     friendly_right_check = _mm256_cmpeq_epi64(friendly_right_check, compare_vec);
     __m256i capture_left_vec = _mm256_andnot_si256(friendly_left_check, left_shift_vec);
     __m256i capture_right_vec = _mm256_andnot_si256(friendly_right_check, right_shift_vec);
-    opponent_vec = _mm256_xor_si256(opponent_vec, capture_left_vec);
-    opponent_vec = _mm256_xor_si256(opponent_vec, capture_right_vec);
-    playing_vec = _mm256_or_si256(playing_vec, capture_left_vec);
-    playing_vec = _mm256_or_si256(playing_vec, capture_right_vec);
-
-    uint64_t playing_data[4];
-    uint64_t opponent_data[4];
-    _mm256_storeu_si256((__m256i *) playing_data, playing_vec);
-    _mm256_storeu_si256((__m256i *) opponent_data, opponent_vec);
-    playing = playing_data[0] | playing_data[1] | playing_data[2] | playing_data[3] | move;
-    opponent = opponent_data[0] & opponent_data[1] & opponent_data[2] & opponent_data[3];
+    __m256i flips_vec = _mm256_or_si256(capture_left_vec, capture_right_vec);
 
-    if (color) {
-        white_bitmap = playing;
-        black_bitmap = opponent;
-    }
-    else {
-        white_bitmap = opponent;
-        black_bitmap = playing;
-    }
+    // add captured lines from each direction together
+    uint64_t flips_data[4];
+    _mm256_storeu_si256((__m256i *) flips_data, flips_vec);
+    return flips_data[0] | flips_data[1] | flips_data[2] | flips_data[3];
+}
+
+ALWAYS_INLINE void BoardAVX2::play_move(bool color, uint64_t move) {
+    apply_move(color, move, flips(color, move));
+}
+
+ALWAYS_INLINE void BoardAVX2::find_frontier(uint64_t &white_frontier, uint64_t &black_frontier, uint64_t &white_potential, uint64_t &black_potential) const {
+    constexpr int64_t LEFT = static_cast<int64_t>(Masks::LEFT_COL_MASK);
+    constexpr int64_t RIGHT = static_cast<int64_t>(Masks::RIGHT_COL_MASK);
+
+    // empty squares, white and black discs are smeared in separate lanes,
+    // horizontal neighbours are masked to prevent wrap around, vertical shift then adds the diagonals
+    uint64_t empty = ~(white_bitmap | black_bitmap);
+    __m256i bitmap_vec = _mm256_set_epi64x(0, black_bitmap, white_bitmap, empty);
+    __m256i left_vec = _mm256_and_si256(_mm256_slli_epi64(bitmap_vec, 1), _mm256_set1_epi64x(LEFT));
+    __m256i right_vec = _mm256_and_si256(_mm256_srli_epi64(bitmap_vec, 1), _mm256_set1_epi64x(RIGHT));
+    __m256i row_vec = _mm256_or_si256(bitmap_vec, _mm256_or_si256(left_vec, right_vec));
+    __m256i smear_vec = _mm256_or_si256(row_vec, _mm256_or_si256(_mm256_slli_epi64(row_vec, 8), _mm256_srli_epi64(row_vec, 8)));
+
+    uint64_t smeared[4];
+    _mm256_storeu_si256((__m256i *) smeared, smear_vec);
+    white_frontier = white_bitmap & smeared[0];
+    black_frontier = black_bitmap & smeared[0];
+    white_potential = empty & smeared[2];
+    black_potential = empty & smeared[1];
 }
@@ -0,0 +1,292 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "board/board_avx512.h"
+#include <immintrin.h>
+#include <bit>
+
+// heuristics map stored as 8bit signed integers, byte i belongs to bit i of the bitmaps
+struct alignas(64) HeurBytes {
+    int8_t values[64];
+};
+
+static constexpr HeurBytes convert_bytes() {
+    HeurBytes bytes = {};
+    for (int i = 0; i < 64; ++i) {
+        bytes.values[i] = static_cast<int8_t>(Board::heuristics_map[63 - i]);
+    }
+    return bytes;
+}
+
+static constexpr HeurBytes heur_bytes = convert_bytes();
+
+// every lane holds one of 8 directions
+//
+// lanes 0-3 shift left, lanes 4-7 shift right
+// 9 -> top left / bottom right
+// 8 -> up / down
+// 7 -> top right / bottom left
+// 1 -> left / right
+static constexpr __mmask8 RIGHT_LANES = 0xf0;
+
+// shifts every lane in its own direction
+static ALWAYS_INLINE __m512i shift_dirs(__m512i vec, __m512i shift_vals_vec) {
+    __m512i left_shift_vec = _mm512_sllv_epi64(vec, shift_vals_vec);
+    return _mm512_mask_srlv_epi64(left_shift_vec, RIGHT_LANES, vec, shift_vals_vec);
+}
+
+// Kogge-Stone occluded fill of generator over propagator, all 8 directions at once
+//
+// vpternlogq with 0xea computes (a & b) | c, which fuses the and/or steps of the fill
+static ALWAYS_INLINE __m512i fill_dirs(__m512i gen_vec, __m512i pro_vec) {
+    __m512i shift_vals_vec = _mm512_set_epi64(9, 8, 7, 1, 9, 8, 7, 1);
+    gen_vec = _mm512_ternarylogic_epi64(shift_dirs(gen_vec, shift_vals_vec), pro_vec, gen_vec, 0xea);
+    pro_vec = _mm512_and_si512(pro_vec, shift_dirs(pro_vec, shift_vals_vec));
+    shift_vals_vec = _mm512_add_epi64(shift_vals_vec, shift_vals_vec);
+    gen_vec = _mm512_ternarylogic_epi64(shift_dirs(gen_vec, shift_vals_vec), pro_vec, gen_vec, 0xea);
+    pro_vec = _mm512_and_si512(pro_vec, shift_dirs(pro_vec, shift_vals_vec));
+    shift_vals_vec = _mm512_add_epi64(shift_vals_vec, shift_vals_vec);
+    gen_vec = _mm512_ternarylogic_epi64(shift_dirs(gen_vec, shift_vals_vec), pro_vec, gen_vec, 0xea);
+    return gen_vec;
+}
+
+// opponent must be masked to prevent wrap around, vertical lanes do not need any mask
+static ALWAYS_INLINE __m512i adjust_opponent(uint64_t opponent) {
+    constexpr int64_t SIDE = static_cast<int64_t>(0x7e7e7e7e7e7e7e7e);
+    __m512i col_mask_vec = _mm512_set_epi64(SIDE, -1, SIDE, SIDE, SIDE, -1, SIDE, SIDE);
+    return _mm512_and_si512(_mm512_set1_epi64(opponent), col_mask_vec);
+}
+
+ALWAYS_INLINE int BoardAVX512::rate_board() const {
+    // bitmaps are directly usable as byte masks, white bytes keep their heuristic value
+    // and black bytes are negated, white and black never overlap so no byte can overflow
+    __m512i heur_vec = _mm512_load_si512(heur_bytes.values);
+    __m512i score_vec = _mm512_maskz_mov_epi8(white_bitmap, heur_vec);
+    score_vec = _mm512_mask_sub_epi8(score_vec, black_bitmap, _mm512_setzero_si512(), heur_vec);
+
+    // flipping the sign bit converts signed bytes into unsigned bytes biased by 128,
+    // those are summed into 8 64bit integers with single sad instruction
+    score_vec = _mm512_xor_si512(score_vec, _mm512_set1_epi8(static_cast<char>(0x80)));
+    score_vec = _mm512_sad_epu8(score_vec, _mm512_setzero_si512());
+    int score = static_cast<int>(_mm512_reduce_add_epi64(score_vec)) - 64 * 128;
+
+    uint64_t white_moves, black_moves;
+    find_moves_both(white_moves, black_moves);
+    int moves_delta = std::popcount(white_moves) - std::popcount(black_moves);
+    score += 10 * moves_delta;
+    return score;
+}
+
+ALWAYS_INLINE uint64_t BoardAVX512::find_moves(bool color) const {
+    // create new bitmap of empty spaces from our two bitmaps so we do not have to check both for empty spaces
+    uint64_t free_spaces = ~(white_bitmap | black_bitmap);
+    // load table of player at turn and opponent player
+    uint64_t playing, opponent;
+    if (color) {
+        playing = white_bitmap;
+        opponent = black_bitmap;
+    }
+    else {
+        playing = black_bitmap;
+        opponent = white_bitmap;
+    }
+
+    // same algorithm as non-vectorized code, uses SIMD
+    // to proccess all 8 directions at once
+    __m512i shift_vals_vec = _mm512_set_epi64(9, 8, 7, 1, 9, 8, 7, 1);
+    __m512i opponent_adjusted_vec = adjust_opponent(opponent);
+    __m512i fill_vec = fill_dirs(_mm512_set1_epi64(playing), opponent_adjusted_vec);
+
+    // only opponent pieces are taken from the fill, moves are right behind them
+    __m512i moves_vec = shift_dirs(_mm512_and_si512(fill_vec, opponent_adjusted_vec), shift_vals_vec);
+    uint64_t valid_moves = _mm512_reduce_or_epi64(moves_vec);
+
+    // mask by free spaces to get the result
+    valid_moves &= free_spaces;
+    // valid moves are returned in form of bitmap
+    return valid_moves;
+}
+
+ALWAYS_INLINE void BoardAVX512::find_moves_both(uint64_t &white_moves, uint64_t &black_moves) const {
+    uint64_t free_spaces = ~(white_bitmap | black_bitmap);
+    __m512i shift_vals_vec = _mm512_set_epi64(9, 8, 7, 1, 9, 8, 7, 1);
+    __m512i white_adjusted_vec = adjust_opponent(white_bitmap);
+    __m512i black_adjusted_vec = adjust_opponent(black_bitmap);
+
+    // fills of both colors are independent, the two dependency chains are interleaved
+    __m512i white_fill_vec = fill_dirs(_mm512_set1_epi64(white_bitmap), black_adjusted_vec);
+    __m512i black_fill_vec = fill_dirs(_mm512_set1_epi64(black_bitmap), white_adjusted_vec);
+    __m512i white_moves_vec = shift_dirs(_mm512_and_si512(white_fill_vec, black_adjusted_vec), shift_vals_vec);
+    __m512i black_moves_vec = shift_dirs(_mm512_and_si512(black_fill_vec, white_adjusted_vec), shift_vals_vec);
+
+    // both reductions share the shuffles, white ends in lane 0 and black in lane 1
+    __m512i joined_vec = _mm512_or_si512(_mm512_unpacklo_epi64(white_moves_vec, black_moves_vec), _mm512_unpackhi_epi64(white_moves_vec, black_moves_vec));
+    __m256i half_vec = _mm256_or_si256(_mm512_castsi512_si256(joined_vec), _mm512_extracti64x4_epi64(joined_vec, 1));
+    __m128i quarter_vec = _mm_or_si128(_mm256_castsi256_si128(half_vec), _mm256_extracti128_si256(half_vec, 1));
+    white_moves = static_cast<uint64_t>(_mm_cvtsi128_si64(quarter_vec)) & free_spaces;
+    black_moves = static_cast<uint64_t>(_mm_extract_epi64(quarter_vec, 1)) & free_spaces;
+}
+
+ALWAYS_INLINE void BoardAVX512::find_stable(uint64_t &white_stable, uint64_t &black_stable) const {
+    constexpr int64_t LEFT = static_cast<int64_t>(Masks::LEFT_COL_MASK);
+    constexpr int64_t RIGHT = static_cast<int64_t>(Masks::RIGHT_COL_MASK);
+    constexpr int64_t EDGE = static_cast<int64_t>(Masks::EDGE_MASK);
+
+    // full lines, lanes 0-3 fill from one edge and lanes 4-7 from the other,
+    // generators are squares with no neighbour behind them in the direction of the fill
+    __m512i occupied_vec = _mm512_set1_epi64(white_bitmap | black_bitmap);
+    __m512i edges_vec = _mm512_set_epi64(static_cast<int64_t>(0xff80808080808080), static_cast<int64_t>(0xff00000000000000),
+                                         static_cast<int64_t>(0xff01010101010101), static_cast<int64_t>(0x8080808080808080),
+                                         0x01010101010101ff, 0x00000000000000ff, static_cast<int64_t>(0x80808080808080ff), 0x0101010101010101);
+    __m512i masks_vec = _mm512_set_epi64(RIGHT, -1, LEFT, RIGHT, LEFT, -1, RIGHT, LEFT);
+    __m512i fill_vec = fill_dirs(_mm512_and_si512(occupied_vec, edges_vec), _mm512_and_si512(occupied_vec, masks_vec));
+    __m512i full_vec = _mm512_and_si512(fill_vec, _mm512_shuffle_i64x2(fill_vec, fill_vec, _MM_SHUFFLE(1, 0, 3, 2)));
+
+    // from now on lanes 0-3 hold directions of white and lanes 4-7 the same directions of black,
+    // squares safe in the direction regardless of neighbours are the same for both
+    __m512i fixed_vec = _mm512_or_si512(full_vec, _mm512_set_epi64(EDGE, static_cast<int64_t>(0xff000000000000ff), EDGE, static_cast<int64_t>(0x8181818181818181),
+                                                                   EDGE, static_cast<int64_t>(0xff000000000000ff), EDGE, static_cast<int64_t>(0x8181818181818181)));
+    __m512i shift_vals_vec = _mm512_set_epi64(9, 8, 7, 1, 9, 8, 7, 1);
+    __m512i mask_left_vec = _mm512_set_epi64(LEFT, -1, RIGHT, LEFT, LEFT, -1, RIGHT, LEFT);
+    __m512i mask_right_vec = _mm512_set_epi64(RIGHT, -1, LEFT, RIGHT, RIGHT, -1, LEFT, RIGHT);
+    __m512i own_vec = _mm512_set_epi64(black_bitmap, black_bitmap, black_bitmap, black_bitmap, white_bitmap, white_bitmap, white_bitmap, white_bitmap);
+
+    __m512i stable_vec = _mm512_setzero_si512();
+    __mmask8 changed;
+    do {
+        // vpternlogq with 0xea computes (a & b) | c
+        __m512i safe_vec = _mm512_ternarylogic_epi64(_mm512_sllv_epi64(stable_vec, shift_vals_vec), mask_left_vec, fixed_vec, 0xea);
+        safe_vec = _mm512_ternarylogic_epi64(_mm512_srlv_epi64(stable_vec, shift_vals_vec), mask_right_vec, safe_vec, 0xea);
+        // disc has to be safe in all directions, permutes stay inside 256-bit halves
+        safe_vec = _mm512_and_si512(safe_vec, _mm512_permutex_epi64(safe_vec, _MM_SHUFFLE(1, 0, 3, 2)));
+        safe_vec = _mm512_and_si512(safe_vec, _mm512_permutex_epi64(safe_vec, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m512i next_vec = _mm512_and_si512(own_vec, safe_vec);
+        changed = _mm512_cmpneq_epi64_mask(next_vec, stable_vec);
+        stable_vec = next_vec;
+    } while (changed);
+
+    white_stable = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm512_castsi512_si128(stable_vec)));
+    black_stable = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm256_castsi256_si128(_mm512_extracti64x4_epi64(stable_vec, 1))));
+}
+
+// shifts all boards in the same direction, positive values shift left, negative right
+template <int dir>
+static ALWAYS_INLINE __m512i shift_boards(__m512i vec) {
+    if constexpr (dir > 0) return _mm512_slli_epi64(vec, dir);
+    else return _mm512_srli_epi64(vec, -dir);
+}
+
+// Kogge-Stone fill of one direction for every board in the vector
+template <int dir>
+static ALWAYS_INLINE __m512i moves_boards(__m512i playing_vec, __m512i opponent_adjusted_vec) {
+    __m512i gen_vec = playing_vec;
+    __m512i pro_vec = opponent_adjusted_vec;
+    gen_vec = _mm512_ternarylogic_epi64(shift_boards<dir>(gen_vec), pro_vec, gen_vec, 0xea);
+    pro_vec = _mm512_and_si512(pro_vec, shift_boards<dir>(pro_vec));
+    gen_vec = _mm512_ternarylogic_epi64(shift_boards<2*dir>(gen_vec), pro_vec, gen_vec, 0xea);
+    pro_vec = _mm512_and_si512(pro_vec, shift_boards<2*dir>(pro_vec));
+    gen_vec = _mm512_ternarylogic_epi64(shift_boards<4*dir>(gen_vec), pro_vec, gen_vec, 0xea);
+    return shift_boards<dir>(_mm512_and_si512(gen_vec, opponent_adjusted_vec));
+}
+
+// moves in all 8 directions for every board in the vector, empty squares are not masked
+static ALWAYS_INLINE __m512i all_moves_boards(__m512i playing_vec, __m512i opponent_vec) {
+    constexpr int64_t SIDE = static_cast<int64_t>(0x7e7e7e7e7e7e7e7e);
+    __m512i opponent_adjusted_vec = _mm512_and_si512(opponent_vec, _mm512_set1_epi64(SIDE));
+    // vpternlogq with 0xfe computes a | b | c
+    __m512i moves_vec = _mm512_ternarylogic_epi64(moves_boards<1>(playing_vec, opponent_adjusted_vec), moves_boards<-1>(playing_vec, opponent_adjusted_vec), moves_boards<7>(playing_vec, opponent_adjusted_vec), 0xfe);
+    moves_vec = _mm512_ternarylogic_epi64(moves_vec, moves_boards<-7>(playing_vec, opponent_adjusted_vec), moves_boards<8>(playing_vec, opponent_vec), 0xfe);
+    moves_vec = _mm512_ternarylogic_epi64(moves_vec, moves_boards<-8>(playing_vec, opponent_vec), moves_boards<9>(playing_vec, opponent_adjusted_vec), 0xfe);
+    return _mm512_or_si512(moves_vec, moves_boards<-9>(playing_vec, opponent_adjusted_vec));
+}
+
+ALWAYS_INLINE void BoardAVX512::mobility_batch(const uint64_t *whites, const uint64_t *blacks, int count, int *moves_delta) {
+    // every lane holds one board, so all lanes shift in the same direction
+    // and immediate shifts can be used instead of variable ones
+    for (int i = 0; i < count; i += 8) {
+        __m512i white_vec = _mm512_loadu_si512(whites + i);
+        __m512i black_vec = _mm512_loadu_si512(blacks + i);
+        __m512i occupied_vec = _mm512_or_si512(white_vec, black_vec);
+        __m512i white_moves_vec = _mm512_andnot_si512(occupied_vec, all_moves_boards(white_vec, black_vec));
+        __m512i black_moves_vec = _mm512_andnot_si512(occupied_vec, all_moves_boards(black_vec, white_vec));
+
+        alignas(64) uint64_t white_moves[8];
+        alignas(64) uint64_t black_moves[8];
+        _mm512_store_si512(white_moves, white_moves_vec);
+        _mm512_store_si512(black_moves, black_moves_vec);
+        for (int j = 0; j < 8; ++j) {
+            moves_delta[i + j] = std::popcount(white_moves[j]) - std::popcount(black_moves[j]);
+        }
+    }
+}
+
+ALWAYS_INLINE uint64_t BoardAVX512::flips(bool color, uint64_t move) const {
+    uint64_t playing, opponent;
+    if (color) {
+        playing = white_bitmap;
+        opponent = black_bitmap;
+    }
+    else {
+        playing = black_bitmap;
+        opponent = white_bitmap;
+    }
+
+    __m512i shift_vals_vec = _mm512_set_epi64(9, 8, 7, 1, 9, 8, 7, 1);
+    __m512i opponent_adjusted_vec = adjust_opponent(opponent);
+    __m512i fill_vec = fill_dirs(_mm512_set1_epi64(move), opponent_adjusted_vec);
+    __m512i line_vec = _mm512_and_si512(fill_vec, opponent_adjusted_vec);
+
+    // line is captured only if the piece right behind it is friendly,
+    // fill is the move together with the line, so the line end is reached by one more shift
+    __mmask8 captured = _mm512_test_epi64_mask(shift_dirs(fill_vec, shift_vals_vec), _mm512_set1_epi64(playing));
+    uint64_t flips = _mm512_mask_reduce_or_epi64(captured, line_vec);
+
+    return flips;
+}
+
+ALWAYS_INLINE void BoardAVX512::play_move(bool color, uint64_t move) {
+    apply_move(color, move, flips(color, move));
+}
+
+ALWAYS_INLINE void BoardAVX512::find_frontier(uint64_t &white_frontier, uint64_t &black_frontier, uint64_t &white_potential, uint64_t &black_potential) const {
+    constexpr int64_t LEFT = static_cast<int64_t>(Masks::LEFT_COL_MASK);
+    constexpr int64_t RIGHT = static_cast<int64_t>(Masks::RIGHT_COL_MASK);
+
+    // empty squares, white and black discs are smeared in separate lanes, same as in AVX2 backend,
+    // vpternlogq with 0xea computes (a & b) | c and with 0xfe a | b | c
+    uint64_t empty = ~(white_bitmap | black_bitmap);
+    __m512i bitmap_vec = _mm512_set_epi64(0, 0, 0, 0, 0, black_bitmap, white_bitmap, empty);
+    __m512i row_vec = _mm512_ternarylogic_epi64(_mm512_slli_epi64(bitmap_vec, 1), _mm512_set1_epi64(LEFT), bitmap_vec, 0xea);
+    row_vec = _mm512_ternarylogic_epi64(_mm512_srli_epi64(bitmap_vec, 1), _mm512_set1_epi64(RIGHT), row_vec, 0xea);
+    __m512i smear_vec = _mm512_ternarylogic_epi64(row_vec, _mm512_slli_epi64(row_vec, 8), _mm512_srli_epi64(row_vec, 8), 0xfe);
+
+    uint64_t smeared[8];
+    _mm512_storeu_si512(smeared, smear_vec);
+    white_frontier = white_bitmap & smeared[0];
+    black_frontier = black_bitmap & smeared[0];
+    white_potential = empty & smeared[2];
+    black_potential = empty & smeared[1];
+}
@@ -0,0 +1,128 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "board/board_bmi2.h"
+#include <immintrin.h>
+#include <bit>
+
+// every square lies on 4 lines - row, column, diagonal and anti-diagonal,
+// masks are used by pext/pdep, position is the index of the square inside extracted line
+struct LineTable {
+    uint64_t masks[64][4];
+    uint8_t positions[64][4];
+};
+
+static constexpr LineTable generate_lines() {
+    LineTable table = {};
+    for (int i = 0; i < 64; ++i) {
+        int row = i / 8;
+        int col = i % 8;
+        uint64_t masks[4] = {0, 0, 0, 0};
+        for (int j = 0; j < 64; ++j) {
+            int r = j / 8;
+            int c = j % 8;
+            if (r == row) masks[0] |= 1ULL << j;
+            if (c == col) masks[1] |= 1ULL << j;
+            if (r - c == row - col) masks[2] |= 1ULL << j;
+            if (r + c == row + col) masks[3] |= 1ULL << j;
+        }
+        for (int dir = 0; dir < 4; ++dir) {
+            table.masks[i][dir] = masks[dir];
+            // pext keeps order of the bits, so position is the number of line squares below the square
+            table.positions[i][dir] = std::popcount(masks[dir] & ((1ULL << i) - 1));
+        }
+    }
+    return table;
+}
+
+// outflank - for move at position and opponent discs of the line, squares right behind
+//            the opponent runs next to the move, playing disc there captures the run
+// flipped  - for move at position and outflanking discs, squares between them
+struct FlipTable {
+    uint8_t outflank[8][256];
+    uint8_t flipped[8][256];
+};
+
+static constexpr FlipTable generate_flips() {
+    FlipTable table = {};
+    for (int pos = 0; pos < 8; ++pos) {
+        for (int line = 0; line < 256; ++line) {
+            // squares past the end of shorter lines are never set in the extracted
+            // playing discs, so no line length checks are needed
+            int outflank = 0;
+            int j = pos + 1;
+            while (j < 8 && ((line >> j) & 1)) j++;
+            if (j > pos + 1 && j < 8) outflank |= 1 << j;
+            j = pos - 1;
+            while (j >= 0 && ((line >> j) & 1)) j--;
+            if (j < pos - 1 && j >= 0) outflank |= 1 << j;
+            table.outflank[pos][line] = outflank;
+
+            int flipped = 0;
+            for (j = pos + 1; j < 8 && ((line >> j) & 1) == 0; ++j);
+            if (j < 8) flipped |= ((1 << j) - 1) & ~((2 << pos) - 1);
+            for (j = pos - 1; j >= 0 && ((line >> j) & 1) == 0; --j);
+            if (j >= 0) flipped |= ((1 << pos) - 1) & ~((2 << j) - 1);
+            table.flipped[pos][line] = flipped;
+        }
+    }
+    return table;
+}
+
+static constexpr LineTable line_table = generate_lines();
+static constexpr FlipTable flip_table = generate_flips();
+
+ALWAYS_INLINE uint64_t BoardBMI2::flips(bool color, uint64_t move) const {
+    uint64_t playing, opponent;
+    if (color) {
+        playing = white_bitmap;
+        opponent = black_bitmap;
+    }
+    else {
+        playing = black_bitmap;
+        opponent = white_bitmap;
+    }
+
+    int square = std::countr_zero(move);
+    uint64_t flips = 0;
+    // lines are independent, loop is unrolled by the compiler
+    for (int dir = 0; dir < 4; ++dir) {
+        uint64_t mask = line_table.masks[square][dir];
+        int pos = line_table.positions[square][dir];
+        int outflank = flip_table.outflank[pos][_pext_u64(opponent, mask)] & _pext_u64(playing, mask);
+        flips |= _pdep_u64(flip_table.flipped[pos][outflank], mask);
+    }
+
+    return flips;
+}
+
+ALWAYS_INLINE void BoardBMI2::play_move(bool color, uint64_t move) {
+    apply_move(color, move, flips(color, move));
+}
+
+ALWAYS_INLINE uint64_t BoardBMI2::extract(uint64_t bitmap, uint64_t mask) {
+    return _pext_u64(bitmap, mask);
+}
@@ -28,20 +28,59 @@
 #include <bit>
 
 ALWAYS_INLINE int Board::rate_board() const {
-    int score = 0;
+    // moves are counted first, so the fills are not kept alive across the loop
+    uint64_t white_moves, black_moves;
+    find_moves_both(white_moves, black_moves);
+    int moves_delta = std::popcount(white_moves) - std::popcount(black_moves);
+    int score = 10 * moves_delta;
+
     for (int i = 0; i < 64; ++i) {
         score += ((white_bitmap >> i) & 1) * heuristics_map[63 - i];
         score -= ((black_bitmap >> i) & 1) * heuristics_map[63 - i];
     }
-    
-    int moves_delta = std::popcount(find_moves(true)) - std::popcount(find_moves(false));
-    score += 10 * moves_delta;
 
     return score;
 }
 
+// shifts bitmap in one of 8 directions, positive values shift left, negative right
+template <int dir>
+static ALWAYS_INLINE uint64_t shift(uint64_t bitmap) {
+    if constexpr (dir > 0) return bitmap << dir;
+    else return bitmap >> -dir;
+}
+
+// Kogge-Stone occluded fill, extends generator bitmap over the propagator bitmap in one direction
+//
+// instead of 6 dependent shift steps, propagator is doubled in every step,
+// so a line of up to 7 squares is covered after only 3 steps
+template <int dir>
+static ALWAYS_INLINE uint64_t fill(uint64_t gen, uint64_t pro) {
+    gen |= pro & shift<dir>(gen);
+    pro &= shift<dir>(pro);
+    gen |= pro & shift<2*dir>(gen);
+    pro &= shift<2*dir>(pro);
+    gen |= pro & shift<4*dir>(gen);
+    return gen;
+}
+
+// squares which are empty and directly behind a line of opponent pieces starting next to playing piece
+template <int dir>
+static ALWAYS_INLINE uint64_t moves_dir(uint64_t playing, uint64_t opponent_adjusted) {
+    // fill contains playing pieces, so only pieces of the opponent are taken from it
+    return shift<dir>(fill<dir>(playing, opponent_adjusted) & opponent_adjusted);
+}
+
+// opponent pieces captured in one direction when move is played
+template <int dir>
+static ALWAYS_INLINE uint64_t flips_dir(uint64_t playing, uint64_t opponent_adjusted, uint64_t move) {
+    uint64_t line = fill<dir>(move, opponent_adjusted) & opponent_adjusted;
+    // line is captured only if it ends with playing piece,
+    // shifted move is a part of the line whenever line is not empty, so it cannot wrap around
+    uint64_t bounded = shift<dir>(line | move) & playing;
+    return bounded ? line : 0;
+}
+
 ALWAYS_INLINE uint64_t Board::find_moves(bool color) const {
-    uint64_t valid_moves = 0;
     // create new bitmap of empty spaces from our two bitmaps so we do not have to check both for empty spaces
     uint64_t free_spaces = ~(white_bitmap | black_bitmap);
     // load table of player at turn and opponent player
@@ -55,40 +94,19 @@ ALWAYS_INLINE uint64_t Board::find_moves(bool color) const {
         opponent = white_bitmap;
     }
 
-    uint64_t dir_copy;
-    uint64_t opponent_adjusted = opponent & Masks::RIGHT_COL_MASK & Masks::LEFT_COL_MASK;
-    // horizontal
-    dir_copy = ((playing << 1) | (playing >> 1)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 1) | (dir_copy >> 1)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 1) | (dir_copy >> 1)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 1) | (dir_copy >> 1)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 1) | (dir_copy >> 1)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 1) | (dir_copy >> 1)) & opponent_adjusted;
-    valid_moves |= (dir_copy << 1) | (dir_copy >> 1);
-    // diagonal from bottom left to top right
-    dir_copy = ((playing << 7) | (playing >> 7)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 7) | (dir_copy >> 7)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 7) | (dir_copy >> 7)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 7) | (dir_copy >> 7)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 7) | (dir_copy >> 7)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 7) | (dir_copy >> 7)) & opponent_adjusted;
-    valid_moves |= (dir_copy << 7) | (dir_copy >> 7);
-    // vertical
-    dir_copy = ((playing << 8) | (playing >> 8)) & opponent;
-    dir_copy |= ((dir_copy << 8) | (dir_copy >> 8)) & opponent;
-    dir_copy |= ((dir_copy << 8) | (dir_copy >> 8)) & opponent;
-    dir_copy |= ((dir_copy << 8) | (dir_copy >> 8)) & opponent;
-    dir_copy |= ((dir_copy << 8) | (dir_copy >> 8)) & opponent;
-    dir_copy |= ((dir_copy << 8) | (dir_copy >> 8)) & opponent;
-    valid_moves |= (dir_copy << 8) | (dir_copy >> 8);
-    // diagonal from bottom right to top left
-    dir_copy = ((playing << 9) | (playing >> 9)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 9) | (dir_copy >> 9)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 9) | (dir_copy >> 9)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 9) | (dir_copy >> 9)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 9) | (dir_copy >> 9)) & opponent_adjusted;
-    dir_copy |= ((dir_copy << 9) | (dir_copy >> 9)) & opponent_adjusted;
-    valid_moves |= (dir_copy << 9) | (dir_copy >> 9);
+    // opponent pieces on side columns can never be captured horizontally or diagonally,
+    // masking them out also prevents lines from wrapping around
+    uint64_t opponent_adjusted = opponent & Masks::SIDE_COLS_MASK;
+
+    // all 8 directions are independent of each other
+    uint64_t valid_moves = moves_dir<1>(playing, opponent_adjusted)  // horizontal
+                         | moves_dir<-1>(playing, opponent_adjusted)
+                         | moves_dir<7>(playing, opponent_adjusted)  // diagonal from bottom left to top right
+                         | moves_dir<-7>(playing, opponent_adjusted)
+                         | moves_dir<8>(playing, opponent)           // vertical
+                         | moves_dir<-8>(playing, opponent)
+                         | moves_dir<9>(playing, opponent_adjusted)  // diagonal from bottom right to top left
+                         | moves_dir<-9>(playing, opponent_adjusted);
 
     // mask by free spaces to get the result
     valid_moves &= free_spaces;
@@ -96,7 +114,105 @@ ALWAYS_INLINE uint64_t Board::find_moves(bool color) const {
     return valid_moves;
 }
 
-ALWAYS_INLINE void Board::play_move(bool color, uint64_t move) {
+ALWAYS_INLINE void Board::find_moves_both(uint64_t &white_moves, uint64_t &black_moves) const {
+    uint64_t free_spaces = ~(white_bitmap | black_bitmap);
+    uint64_t white_adjusted = white_bitmap & Masks::SIDE_COLS_MASK;
+    uint64_t black_adjusted = black_bitmap & Masks::SIDE_COLS_MASK;
+
+    // directions of both colors are interleaved, so there are 16 independent fills
+    // for the out-of-order core to overlap instead of two chains of 8
+    uint64_t white_h = moves_dir<1>(white_bitmap, black_adjusted) | moves_dir<-1>(white_bitmap, black_adjusted);
+    uint64_t black_h = moves_dir<1>(black_bitmap, white_adjusted) | moves_dir<-1>(black_bitmap, white_adjusted);
+    uint64_t white_d7 = moves_dir<7>(white_bitmap, black_adjusted) | moves_dir<-7>(white_bitmap, black_adjusted);
+    uint64_t black_d7 = moves_dir<7>(black_bitmap, white_adjusted) | moves_dir<-7>(black_bitmap, white_adjusted);
+    uint64_t white_v = moves_dir<8>(white_bitmap, black_bitmap) | moves_dir<-8>(white_bitmap, black_bitmap);
+    uint64_t black_v = moves_dir<8>(black_bitmap, white_bitmap) | moves_dir<-8>(black_bitmap, white_bitmap);
+    uint64_t white_d9 = moves_dir<9>(white_bitmap, black_adjusted) | moves_dir<-9>(white_bitmap, black_adjusted);
+    uint64_t black_d9 = moves_dir<9>(black_bitmap, white_adjusted) | moves_dir<-9>(black_bitmap, white_adjusted);
+
+    white_moves = (white_h | white_d7 | white_v | white_d9) & free_spaces;
+    black_moves = (black_h | black_d7 | black_v | black_d9) & free_spaces;
+}
+
+ALWAYS_INLINE void Board::mobility_batch(const uint64_t *whites, const uint64_t *blacks, int count, int *moves_delta) {
+    // scalar code has no lanes, boards are processed one by one with the fused kernel
+    for (int i = 0; i < count; ++i) {
+        uint64_t white_moves, black_moves;
+        Board(whites[i], blacks[i]).find_moves_both(white_moves, black_moves);
+        moves_delta[i] = std::popcount(white_moves) - std::popcount(black_moves);
+    }
+}
+
+// squares connected to the edge by a line of occupied squares, filled from both ends of the line
+template <int dir>
+static ALWAYS_INLINE uint64_t full_dir(uint64_t occupied, uint64_t edge_left, uint64_t mask_left, uint64_t edge_right, uint64_t mask_right) {
+    return fill<dir>(occupied & edge_left, occupied & mask_left) & fill<-dir>(occupied & edge_right, occupied & mask_right);
+}
+
+ALWAYS_INLINE void Board::full_lines(uint64_t occupied, uint64_t *full) {
+    // generators are squares with no neighbour behind them in the direction of the fill,
+    // propagators are masked to prevent wrap around like in the move generation
+    full[0] = full_dir<1>(occupied, 0x0101010101010101, Masks::LEFT_COL_MASK, 0x8080808080808080, Masks::RIGHT_COL_MASK);
+    full[1] = full_dir<7>(occupied, 0x80808080808080ff, Masks::RIGHT_COL_MASK, 0xff01010101010101, Masks::LEFT_COL_MASK);
+    full[2] = full_dir<8>(occupied, 0x00000000000000ff, Masks::NO_COL_MASK, 0xff00000000000000, Masks::NO_COL_MASK);
+    full[3] = full_dir<9>(occupied, 0x01010101010101ff, Masks::LEFT_COL_MASK, 0xff80808080808080, Masks::RIGHT_COL_MASK);
+}
+
+// squares which are safe in one direction, because of full line, edge or stable neighbour
+template <int dir>
+static ALWAYS_INLINE uint64_t safe_dir(uint64_t fixed, uint64_t stable, uint64_t mask_left, uint64_t mask_right) {
+    return fixed | (shift<dir>(stable) & mask_left) | (shift<-dir>(stable) & mask_right);
+}
+
+ALWAYS_INLINE void Board::find_stable(uint64_t &white_stable, uint64_t &black_stable) const {
+    uint64_t full[4];
+    full_lines(white_bitmap | black_bitmap, full);
+    // squares safe in the direction regardless of neighbours
+    uint64_t fixed_h = full[0] | 0x8181818181818181;
+    uint64_t fixed_d7 = full[1] | Masks::EDGE_MASK;
+    uint64_t fixed_v = full[2] | 0xff000000000000ff;
+    uint64_t fixed_d9 = full[3] | Masks::EDGE_MASK;
+
+    // stable sets only grow, both colors are iterated together until neither changes
+    uint64_t white = 0, black = 0;
+    uint64_t white_prev, black_prev;
+    do {
+        white_prev = white;
+        black_prev = black;
+        white = white_bitmap
+              & safe_dir<1>(fixed_h, white_prev, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK)
+              & safe_dir<7>(fixed_d7, white_prev, Masks::RIGHT_COL_MASK, Masks::LEFT_COL_MASK)
+              & safe_dir<8>(fixed_v, white_prev, Masks::NO_COL_MASK, Masks::NO_COL_MASK)
+              & safe_dir<9>(fixed_d9, white_prev, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK);
+        black = black_bitmap
+              & safe_dir<1>(fixed_h, black_prev, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK)
+              & safe_dir<7>(fixed_d7, black_prev, Masks::RIGHT_COL_MASK, Masks::LEFT_COL_MASK)
+              & safe_dir<8>(fixed_v, black_prev, Masks::NO_COL_MASK, Masks::NO_COL_MASK)
+              & safe_dir<9>(fixed_d9, black_prev, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK);
+    } while (white != white_prev || black != black_prev);
+
+    white_stable = white;
+    black_stable = black;
+}
+
+// bitmap together with all of its 8 neighbours, left and right neighbours are masked
+// to prevent wrap around, vertical shift of the row then adds the diagonals
+static ALWAYS_INLINE uint64_t smear(uint64_t bitmap, uint64_t mask_left, uint64_t mask_right) {
+    uint64_t row = bitmap | ((bitmap << 1) & mask_left) | ((bitmap >> 1) & mask_right);
+    return row | (row << 8) | (row >> 8);
+}
+
+ALWAYS_INLINE void Board::find_frontier(uint64_t &white_frontier, uint64_t &black_frontier, uint64_t &white_potential, uint64_t &black_potential) const {
+    // smeared bitmaps contain the discs themselves, those are removed by the masks
+    uint64_t empty = ~(white_bitmap | black_bitmap);
+    uint64_t near_empty = smear(empty, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK);
+    white_frontier = white_bitmap & near_empty;
+    black_frontier = black_bitmap & near_empty;
+    white_potential = empty & smear(black_bitmap, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK);
+    black_potential = empty & smear(white_bitmap, Masks::LEFT_COL_MASK, Masks::RIGHT_COL_MASK);
+}
+
+ALWAYS_INLINE uint64_t Board::flips(bool color, uint64_t move) const {
     uint64_t playing, opponent;
     if (color) {
         playing = white_bitmap;
@@ -107,39 +223,19 @@ ALWAYS_INLINE void Board::play_move(bool color, uint64_t move) {
         opponent = white_bitmap;
     }
 
-    auto check_dir = [&](uint64_t col_mask, int shift) {
-        bool found = false;
-        uint64_t playing_adjusted = playing & col_mask;
-        uint64_t opponent_adjusted = opponent & col_mask;
-        uint64_t offset = (shift < 0) ? (move << (-shift)) : (move >> shift);
-        uint64_t line = 0;
-        while (opponent_adjusted & offset) {
-            found = true;
-            line |= offset;
-            offset = (shift < 0) ? (offset << (-shift)) : (offset >> shift);
-        }
-        if (found && (playing_adjusted & offset)) {
-            playing |= line;
-            opponent ^= line;
-        }
-    };
-
-    playing |= move; // capture the space
-    check_dir(Masks::LEFT_COL_MASK ,-9); // top left
-    check_dir(Masks::NO_COL_MASK   ,-8); // top
-    check_dir(Masks::RIGHT_COL_MASK,-7); // top right
-    check_dir(Masks::LEFT_COL_MASK ,-1); // left
-    check_dir(Masks::RIGHT_COL_MASK, 1); // right
-    check_dir(Masks::LEFT_COL_MASK , 7); // bottom left
-    check_dir(Masks::NO_COL_MASK   , 8); // bottom
-    check_dir(Masks::RIGHT_COL_MASK, 9); // bottom right*/
+    uint64_t opponent_adjusted = opponent & Masks::SIDE_COLS_MASK;
+    uint64_t flips = flips_dir<9>(playing, opponent_adjusted, move)  // top left
+                   | flips_dir<8>(playing, opponent, move)           // top
+                   | flips_dir<7>(playing, opponent_adjusted, move)  // top right
+                   | flips_dir<1>(playing, opponent_adjusted, move)  // left
+                   | flips_dir<-1>(playing, opponent_adjusted, move) // right
+                   | flips_dir<-7>(playing, opponent_adjusted, move) // bottom left
+                   | flips_dir<-8>(playing, opponent, move)          // bottom
+                   | flips_dir<-9>(playing, opponent_adjusted, move);// bottom right
 
-    if (color) {
-        white_bitmap = playing;
-        black_bitmap = opponent;
-    }
-    else {
-        white_bitmap = opponent;
-        black_bitmap = playing;
-    }
+    return flips;
+}
+
+ALWAYS_INLINE void Board::play_move(bool color, uint64_t move) {
+    apply_move(color, move, flips(color, move));
 }
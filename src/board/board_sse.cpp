@@ -0,0 +1,336 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "board/board_sse.h"
+#include <tmmintrin.h>
+#include <bit>
+
+// heuristics map stored as 8bit signed integers, byte i belongs to bit i of the bitmaps
+struct alignas(16) HeurBytesSSE {
+    int8_t values[64];
+};
+
+static constexpr HeurBytesSSE convert_bytes_sse() {
+    HeurBytesSSE bytes = {};
+    for (int i = 0; i < 64; ++i) {
+        bytes.values[i] = static_cast<int8_t>(Board::heuristics_map[63 - i]);
+    }
+    return bytes;
+}
+
+static constexpr HeurBytesSSE heur_bytes = convert_bytes_sse();
+
+// SSE has no per-lane shifts, so every register holds the board in lane 0 and
+// the same board flipped vertically in lane 1, in the flipped board rows go the other way
+// so one left shift moves the lanes in two different directions
+//
+// 9 -> top left / bottom left
+// 7 -> top right / bottom right
+// 8 -> up / down
+// 1 -> left / right (lane 0 is shifted left and lane 1 right)
+
+// loads bitmap into lane 0 and the vertically flipped bitmap into lane 1
+static ALWAYS_INLINE __m128i load_pair(uint64_t bitmap) {
+    const __m128i flip_vec = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm_shuffle_epi8(_mm_cvtsi64_si128(bitmap), flip_vec);
+}
+
+// flips lane 1 back and joins it with lane 0
+static ALWAYS_INLINE uint64_t join_pair(__m128i vec) {
+    const __m128i unflip_vec = _mm_set_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_cvtsi128_si64(_mm_or_si128(vec, _mm_shuffle_epi8(vec, unflip_vec)));
+}
+
+// shifts both lanes in their own direction
+template <int dist>
+static ALWAYS_INLINE __m128i shift_pair(__m128i vec) {
+    if constexpr (dist == 1 || dist == 2 || dist == 4) {
+        // horizontal pair, lane 0 is taken from left shift and lane 1 from right shift
+        __m128i left_vec = _mm_slli_epi64(vec, dist);
+        __m128i right_vec = _mm_srli_epi64(vec, dist);
+        return _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(right_vec), _mm_castsi128_pd(left_vec)));
+    }
+    else {
+        return _mm_slli_epi64(vec, dist);
+    }
+}
+
+// Kogge-Stone occluded fill in two directions at once, same as in the portable backend
+template <int dist>
+static ALWAYS_INLINE __m128i fill_pair(__m128i gen_vec, __m128i pro_vec) {
+    gen_vec = _mm_or_si128(gen_vec, _mm_and_si128(pro_vec, shift_pair<dist>(gen_vec)));
+    pro_vec = _mm_and_si128(pro_vec, shift_pair<dist>(pro_vec));
+    gen_vec = _mm_or_si128(gen_vec, _mm_and_si128(pro_vec, shift_pair<2*dist>(gen_vec)));
+    pro_vec = _mm_and_si128(pro_vec, shift_pair<2*dist>(pro_vec));
+    gen_vec = _mm_or_si128(gen_vec, _mm_and_si128(pro_vec, shift_pair<4*dist>(gen_vec)));
+    return gen_vec;
+}
+
+// squares behind lines of opponent pieces starting next to playing piece
+template <int dist>
+static ALWAYS_INLINE __m128i moves_pair(__m128i playing_vec, __m128i opponent_adjusted_vec) {
+    return shift_pair<dist>(_mm_and_si128(fill_pair<dist>(playing_vec, opponent_adjusted_vec), opponent_adjusted_vec));
+}
+
+// opponent pieces captured when move is played
+template <int dist>
+static ALWAYS_INLINE __m128i flips_pair(__m128i playing_vec, __m128i opponent_adjusted_vec, __m128i move_vec) {
+    __m128i fill_vec = fill_pair<dist>(move_vec, opponent_adjusted_vec);
+    __m128i line_vec = _mm_and_si128(fill_vec, opponent_adjusted_vec);
+    // line is captured only if the piece right behind it is friendly,
+    // SSE2 cannot compare 64bit integers, 32bit halves are compared and combined instead
+    __m128i bounded_vec = _mm_and_si128(shift_pair<dist>(fill_vec), playing_vec);
+    __m128i empty_vec = _mm_cmpeq_epi32(bounded_vec, _mm_setzero_si128());
+    empty_vec = _mm_and_si128(empty_vec, _mm_shuffle_epi32(empty_vec, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_andnot_si128(empty_vec, line_vec);
+}
+
+ALWAYS_INLINE int BoardSSE::rate_board() const {
+    // every register covers two rows of the board, row bytes are broadcasted
+    // into 8 byte lanes and each lane keeps only its own bit
+    const __m128i bit_vec = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+    const __m128i ones_vec = _mm_set1_epi8(1);
+    __m128i white_vec = _mm_cvtsi64_si128(white_bitmap);
+    __m128i black_vec = _mm_cvtsi64_si128(black_bitmap);
+    __m128i sum_vec = _mm_setzero_si128();
+
+    for (int i = 0; i < 4; ++i) {
+        __m128i rows_vec = _mm_set_epi8(2*i+1, 2*i+1, 2*i+1, 2*i+1, 2*i+1, 2*i+1, 2*i+1, 2*i+1, 2*i, 2*i, 2*i, 2*i, 2*i, 2*i, 2*i, 2*i);
+        // -1 on squares with a piece, 0 elsewhere
+        __m128i white_bytes = _mm_cmpeq_epi8(_mm_and_si128(_mm_shuffle_epi8(white_vec, rows_vec), bit_vec), bit_vec);
+        __m128i black_bytes = _mm_cmpeq_epi8(_mm_and_si128(_mm_shuffle_epi8(black_vec, rows_vec), bit_vec), bit_vec);
+        // 1 for white, -1 for black, 0 for empty squares, used to set sign of heuristic values
+        __m128i sign_vec = _mm_sub_epi8(black_bytes, white_bytes);
+        __m128i heur_vec = _mm_load_si128(reinterpret_cast<const __m128i *>(heur_bytes.values + 16*i));
+        // sum neighbouring signed bytes into 16bit integers
+        sum_vec = _mm_add_epi16(sum_vec, _mm_maddubs_epi16(ones_vec, _mm_sign_epi8(heur_vec, sign_vec)));
+    }
+
+    // sum 16bit integers into 32bit integers and add them together
+    sum_vec = _mm_madd_epi16(sum_vec, _mm_set1_epi16(1));
+    sum_vec = _mm_add_epi32(sum_vec, _mm_shuffle_epi32(sum_vec, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum_vec = _mm_add_epi32(sum_vec, _mm_shuffle_epi32(sum_vec, _MM_SHUFFLE(2, 3, 0, 1)));
+    int score = _mm_cvtsi128_si32(sum_vec);
+
+    uint64_t white_moves, black_moves;
+    find_moves_both(white_moves, black_moves);
+    int moves_delta = std::popcount(white_moves) - std::popcount(black_moves);
+    score += 10 * moves_delta;
+    return score;
+}
+
+ALWAYS_INLINE uint64_t BoardSSE::find_moves(bool color) const {
+    // create new bitmap of empty spaces from our two bitmaps so we do not have to check both for empty spaces
+    uint64_t free_spaces = ~(white_bitmap | black_bitmap);
+    // load table of player at turn and opponent player
+    uint64_t playing, opponent;
+    if (color) {
+        playing = white_bitmap;
+        opponent = black_bitmap;
+    }
+    else {
+        playing = black_bitmap;
+        opponent = white_bitmap;
+    }
+
+    // same algorithm as non-vectorized code, uses SIMD to proccess 2 directions at once,
+    // opponent is masked to prevent wrap around, vertical directions do not need any mask
+    __m128i playing_vec = load_pair(playing);
+    __m128i opponent_vec = load_pair(opponent);
+    __m128i opponent_adjusted_vec = load_pair(opponent & Masks::SIDE_COLS_MASK);
+
+    __m128i moves_vec = moves_pair<1>(playing_vec, opponent_adjusted_vec);
+    moves_vec = _mm_or_si128(moves_vec, moves_pair<7>(playing_vec, opponent_adjusted_vec));
+    moves_vec = _mm_or_si128(moves_vec, moves_pair<8>(playing_vec, opponent_vec));
+    moves_vec = _mm_or_si128(moves_vec, moves_pair<9>(playing_vec, opponent_adjusted_vec));
+    uint64_t valid_moves = join_pair(moves_vec);
+
+    // mask by free spaces to get the result
+    valid_moves &= free_spaces;
+    // valid moves are returned in form of bitmap
+    return valid_moves;
+}
+
+ALWAYS_INLINE void BoardSSE::find_moves_both(uint64_t &white_moves, uint64_t &black_moves) const {
+    uint64_t free_spaces = ~(white_bitmap | black_bitmap);
+    __m128i white_vec = load_pair(white_bitmap);
+    __m128i black_vec = load_pair(black_bitmap);
+    __m128i white_adjusted_vec = load_pair(white_bitmap & Masks::SIDE_COLS_MASK);
+    __m128i black_adjusted_vec = load_pair(black_bitmap & Masks::SIDE_COLS_MASK);
+
+    // pairs of both colors are interleaved, 8 independent fills keep all vector ports busy
+    __m128i white_moves_vec = moves_pair<1>(white_vec, black_adjusted_vec);
+    __m128i black_moves_vec = moves_pair<1>(black_vec, white_adjusted_vec);
+    white_moves_vec = _mm_or_si128(white_moves_vec, moves_pair<7>(white_vec, black_adjusted_vec));
+    black_moves_vec = _mm_or_si128(black_moves_vec, moves_pair<7>(black_vec, white_adjusted_vec));
+    white_moves_vec = _mm_or_si128(white_moves_vec, moves_pair<8>(white_vec, black_vec));
+    black_moves_vec = _mm_or_si128(black_moves_vec, moves_pair<8>(black_vec, white_vec));
+    white_moves_vec = _mm_or_si128(white_moves_vec, moves_pair<9>(white_vec, black_adjusted_vec));
+    black_moves_vec = _mm_or_si128(black_moves_vec, moves_pair<9>(black_vec, white_adjusted_vec));
+
+    white_moves = join_pair(white_moves_vec) & free_spaces;
+    black_moves = join_pair(black_moves_vec) & free_spaces;
+}
+
+// squares of both colors safe in one direction, because of full line, edge or stable neighbour,
+// lanes hold the two colors, so both shift in the same direction
+template <int dir>
+static ALWAYS_INLINE __m128i safe_colors(__m128i fixed_vec, __m128i stable_vec, __m128i mask_left_vec, __m128i mask_right_vec) {
+    __m128i left_vec = _mm_and_si128(_mm_slli_epi64(stable_vec, dir), mask_left_vec);
+    __m128i right_vec = _mm_and_si128(_mm_srli_epi64(stable_vec, dir), mask_right_vec);
+    return _mm_or_si128(fixed_vec, _mm_or_si128(left_vec, right_vec));
+}
+
+ALWAYS_INLINE void BoardSSE::find_stable(uint64_t &white_stable, uint64_t &black_stable) const {
+    // full lines take the portable fills, flipped pairs cover two different axes instead of both ends of one
+    uint64_t full[4];
+    full_lines(white_bitmap | black_bitmap, full);
+    __m128i fixed_h_vec = _mm_set1_epi64x(full[0] | 0x8181818181818181);
+    __m128i fixed_d7_vec = _mm_set1_epi64x(full[1] | Masks::EDGE_MASK);
+    __m128i fixed_v_vec = _mm_set1_epi64x(full[2] | 0xff000000000000ff);
+    __m128i fixed_d9_vec = _mm_set1_epi64x(full[3] | Masks::EDGE_MASK);
+    __m128i left_vec = _mm_set1_epi64x(Masks::LEFT_COL_MASK);
+    __m128i right_vec = _mm_set1_epi64x(Masks::RIGHT_COL_MASK);
+    __m128i all_vec = _mm_set1_epi64x(-1);
+
+    // white is in lane 0 and black in lane 1
+    __m128i own_vec = _mm_set_epi64x(black_bitmap, white_bitmap);
+    __m128i stable_vec = _mm_setzero_si128();
+    int unchanged;
+    do {
+        __m128i next_vec = _mm_and_si128(own_vec, safe_colors<1>(fixed_h_vec, stable_vec, left_vec, right_vec));
+        next_vec = _mm_and_si128(next_vec, safe_colors<7>(fixed_d7_vec, stable_vec, right_vec, left_vec));
+        next_vec = _mm_and_si128(next_vec, safe_colors<8>(fixed_v_vec, stable_vec, all_vec, all_vec));
+        next_vec = _mm_and_si128(next_vec, safe_colors<9>(fixed_d9_vec, stable_vec, left_vec, right_vec));
+        // SSE2 cannot compare 64bit integers, all 32bit halves are compared instead
+        unchanged = _mm_movemask_epi8(_mm_cmpeq_epi32(next_vec, stable_vec)) == 0xffff;
+        stable_vec = next_vec;
+    } while (!unchanged);
+
+    white_stable = static_cast<uint64_t>(_mm_cvtsi128_si64(stable_vec));
+    black_stable = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(stable_vec, stable_vec)));
+}
+
+// shifts all boards in the same direction, positive values shift left, negative right
+template <int dir>
+static ALWAYS_INLINE __m128i shift_boards(__m128i vec) {
+    if constexpr (dir > 0) return _mm_slli_epi64(vec, dir);
+    else return _mm_srli_epi64(vec, -dir);
+}
+
+// Kogge-Stone fill of one direction for every board in the vector
+template <int dir>
+static ALWAYS_INLINE __m128i moves_boards(__m128i playing_vec, __m128i opponent_adjusted_vec) {
+    __m128i gen_vec = playing_vec;
+    __m128i pro_vec = opponent_adjusted_vec;
+    gen_vec = _mm_or_si128(gen_vec, _mm_and_si128(pro_vec, shift_boards<dir>(gen_vec)));
+    pro_vec = _mm_and_si128(pro_vec, shift_boards<dir>(pro_vec));
+    gen_vec = _mm_or_si128(gen_vec, _mm_and_si128(pro_vec, shift_boards<2*dir>(gen_vec)));
+    pro_vec = _mm_and_si128(pro_vec, shift_boards<2*dir>(pro_vec));
+    gen_vec = _mm_or_si128(gen_vec, _mm_and_si128(pro_vec, shift_boards<4*dir>(gen_vec)));
+    return shift_boards<dir>(_mm_and_si128(gen_vec, opponent_adjusted_vec));
+}
+
+// moves in all 8 directions for every board in the vector, empty squares are not masked
+static ALWAYS_INLINE __m128i all_moves_boards(__m128i playing_vec, __m128i opponent_vec) {
+    constexpr int64_t SIDE = static_cast<int64_t>(0x7e7e7e7e7e7e7e7e);
+    __m128i opponent_adjusted_vec = _mm_and_si128(opponent_vec, _mm_set1_epi64x(SIDE));
+    __m128i moves_vec = _mm_or_si128(moves_boards<1>(playing_vec, opponent_adjusted_vec), moves_boards<-1>(playing_vec, opponent_adjusted_vec));
+    moves_vec = _mm_or_si128(moves_vec, _mm_or_si128(moves_boards<7>(playing_vec, opponent_adjusted_vec), moves_boards<-7>(playing_vec, opponent_adjusted_vec)));
+    moves_vec = _mm_or_si128(moves_vec, _mm_or_si128(moves_boards<8>(playing_vec, opponent_vec), moves_boards<-8>(playing_vec, opponent_vec)));
+    moves_vec = _mm_or_si128(moves_vec, _mm_or_si128(moves_boards<9>(playing_vec, opponent_adjusted_vec), moves_boards<-9>(playing_vec, opponent_adjusted_vec)));
+    return moves_vec;
+}
+
+ALWAYS_INLINE void BoardSSE::mobility_batch(const uint64_t *whites, const uint64_t *blacks, int count, int *moves_delta) {
+    // every lane holds one board, so all lanes shift in the same direction
+    for (int i = 0; i < count; i += 2) {
+        __m128i white_vec = _mm_loadu_si128(reinterpret_cast<const __m128i *>(whites + i));
+        __m128i black_vec = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blacks + i));
+        __m128i occupied_vec = _mm_or_si128(white_vec, black_vec);
+        __m128i white_moves_vec = _mm_andnot_si128(occupied_vec, all_moves_boards(white_vec, black_vec));
+        __m128i black_moves_vec = _mm_andnot_si128(occupied_vec, all_moves_boards(black_vec, white_vec));
+
+        alignas(16) uint64_t white_moves[2];
+        alignas(16) uint64_t black_moves[2];
+        _mm_store_si128(reinterpret_cast<__m128i *>(white_moves), white_moves_vec);
+        _mm_store_si128(reinterpret_cast<__m128i *>(black_moves), black_moves_vec);
+        for (int j = 0; j < 2; ++j) {
+            moves_delta[i + j] = std::popcount(white_moves[j]) - std::popcount(black_moves[j]);
+        }
+    }
+}
+
+ALWAYS_INLINE uint64_t BoardSSE::flips(bool color, uint64_t move) const {
+    uint64_t playing, opponent;
+    if (color) {
+        playing = white_bitmap;
+        opponent = black_bitmap;
+    }
+    else {
+        playing = black_bitmap;
+        opponent = white_bitmap;
+    }
+
+    __m128i playing_vec = load_pair(playing);
+    __m128i opponent_vec = load_pair(opponent);
+    __m128i opponent_adjusted_vec = load_pair(opponent & Masks::SIDE_COLS_MASK);
+    __m128i move_vec = load_pair(move);
+
+    __m128i flips_vec = flips_pair<1>(playing_vec, opponent_adjusted_vec, move_vec);
+    flips_vec = _mm_or_si128(flips_vec, flips_pair<7>(playing_vec, opponent_adjusted_vec, move_vec));
+    flips_vec = _mm_or_si128(flips_vec, flips_pair<8>(playing_vec, opponent_vec, move_vec));
+    flips_vec = _mm_or_si128(flips_vec, flips_pair<9>(playing_vec, opponent_adjusted_vec, move_vec));
+    uint64_t flips = join_pair(flips_vec);
+
+    return flips;
+}
+
+ALWAYS_INLINE void BoardSSE::play_move(bool color, uint64_t move) {
+    apply_move(color, move, flips(color, move));
+}
+
+ALWAYS_INLINE void BoardSSE::find_frontier(uint64_t &white_frontier, uint64_t &black_frontier, uint64_t &white_potential, uint64_t &black_potential) const {
+    constexpr int64_t LEFT = static_cast<int64_t>(Masks::LEFT_COL_MASK);
+    constexpr int64_t RIGHT = static_cast<int64_t>(Masks::RIGHT_COL_MASK);
+
+    // lanes hold white and black discs unflipped, empty squares are smeared in the integer unit
+    // alongside them, horizontal neighbours are masked to prevent wrap around
+    // and vertical shift then adds the diagonals
+    uint64_t empty = ~(white_bitmap | black_bitmap);
+    __m128i colors_vec = _mm_set_epi64x(static_cast<int64_t>(black_bitmap), static_cast<int64_t>(white_bitmap));
+    __m128i left_vec = _mm_and_si128(_mm_slli_epi64(colors_vec, 1), _mm_set1_epi64x(LEFT));
+    __m128i right_vec = _mm_and_si128(_mm_srli_epi64(colors_vec, 1), _mm_set1_epi64x(RIGHT));
+    __m128i row_vec = _mm_or_si128(colors_vec, _mm_or_si128(left_vec, right_vec));
+    __m128i smear_vec = _mm_or_si128(row_vec, _mm_or_si128(_mm_slli_epi64(row_vec, 8), _mm_srli_epi64(row_vec, 8)));
+
+    uint64_t empty_row = empty | ((empty << 1) & Masks::LEFT_COL_MASK) | ((empty >> 1) & Masks::RIGHT_COL_MASK);
+    uint64_t near_empty = empty_row | (empty_row << 8) | (empty_row >> 8);
+    white_frontier = white_bitmap & near_empty;
+    black_frontier = black_bitmap & near_empty;
+    white_potential = empty & static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(smear_vec, smear_vec)));
+    black_potential = empty & static_cast<uint64_t>(_mm_cvtsi128_si64(smear_vec));
+}
@@ -47,6 +47,28 @@ ALWAYS_INLINE int Board::count_black() const {
     return std::popcount(black_bitmap);
 }
 
+ALWAYS_INLINE void Board::apply_move(bool color, uint64_t move, uint64_t flips) {
+    if (color) {
+        white_bitmap |= move | flips; // capture the space and the lines
+        black_bitmap ^= flips;
+    }
+    else {
+        black_bitmap |= move | flips;
+        white_bitmap ^= flips;
+    }
+}
+
+ALWAYS_INLINE void Board::undo_move(bool color, uint64_t move, uint64_t flips) {
+    if (color) {
+        white_bitmap ^= move | flips; // release the space and return the lines
+        black_bitmap |= flips;
+    }
+    else {
+        black_bitmap ^= move | flips;
+        white_bitmap |= flips;
+    }
+}
+
 ALWAYS_INLINE uint64_t Board::hash() const {
     // Murmur hash of white
     uint64_t w = white_bitmap;
@@ -66,6 +88,75 @@ ALWAYS_INLINE uint64_t Board::hash() const {
     return w ^ b;
 }
 
+ALWAYS_INLINE uint64_t Board::flip_vertical(uint64_t bitmap) {
+    bitmap = ((bitmap >> 8) & 0x00ff00ff00ff00ff) | ((bitmap & 0x00ff00ff00ff00ff) << 8);
+    bitmap = ((bitmap >> 16) & 0x0000ffff0000ffff) | ((bitmap & 0x0000ffff0000ffff) << 16);
+    return (bitmap >> 32) | (bitmap << 32);
+}
+
+ALWAYS_INLINE uint64_t Board::mirror_horizontal(uint64_t bitmap) {
+    bitmap = ((bitmap >> 1) & 0x5555555555555555) | ((bitmap & 0x5555555555555555) << 1);
+    bitmap = ((bitmap >> 2) & 0x3333333333333333) | ((bitmap & 0x3333333333333333) << 2);
+    return ((bitmap >> 4) & 0x0f0f0f0f0f0f0f0f) | ((bitmap & 0x0f0f0f0f0f0f0f0f) << 4);
+}
+
+ALWAYS_INLINE uint64_t Board::transpose(uint64_t bitmap) {
+    // delta swaps of 4x4, 2x2 and single square blocks across the main diagonal
+    uint64_t t = 0x0f0f0f0f00000000 & (bitmap ^ (bitmap << 28));
+    bitmap ^= t ^ (t >> 28);
+    t = 0x3333000033330000 & (bitmap ^ (bitmap << 14));
+    bitmap ^= t ^ (t >> 14);
+    t = 0x5500550055005500 & (bitmap ^ (bitmap << 7));
+    return bitmap ^ t ^ (t >> 7);
+}
+
+ALWAYS_INLINE uint64_t Board::transform(uint64_t bitmap, int symmetry) {
+    if (symmetry & 4) bitmap = transpose(bitmap);
+    if (symmetry & 2) bitmap = flip_vertical(bitmap);
+    if (symmetry & 1) bitmap = mirror_horizontal(bitmap);
+    return bitmap;
+}
+
+ALWAYS_INLINE uint64_t Board::untransform(uint64_t bitmap, int symmetry) {
+    // every step is its own inverse, they are only undone in reverse order
+    if (symmetry & 1) bitmap = mirror_horizontal(bitmap);
+    if (symmetry & 2) bitmap = flip_vertical(bitmap);
+    if (symmetry & 4) bitmap = transpose(bitmap);
+    return bitmap;
+}
+
+ALWAYS_INLINE int Board::canonical(Board &canonical) const {
+    // images of the same symmetry as in transform(), transposition is shared by half of them
+    uint64_t whites[8], blacks[8];
+    whites[0] = white_bitmap;
+    blacks[0] = black_bitmap;
+    whites[4] = transpose(white_bitmap);
+    blacks[4] = transpose(black_bitmap);
+    whites[2] = flip_vertical(whites[0]);
+    blacks[2] = flip_vertical(blacks[0]);
+    whites[6] = flip_vertical(whites[4]);
+    blacks[6] = flip_vertical(blacks[4]);
+    for (int i = 0; i < 8; i += 2) {
+        whites[i + 1] = mirror_horizontal(whites[i]);
+        blacks[i + 1] = mirror_horizontal(blacks[i]);
+    }
+
+    int best = 0;
+    for (int i = 1; i < 8; ++i) {
+        if (whites[i] < whites[best] || (whites[i] == whites[best] && blacks[i] < blacks[best])) {
+            best = i;
+        }
+    }
+    canonical = Board(whites[best], blacks[best]);
+    return best;
+}
+
+ALWAYS_INLINE uint64_t Board::canonical_hash() const {
+    Board board;
+    canonical(board);
+    return board.hash();
+}
+
 const Board Board::States::INITIAL = Board(
     // or operations just for readability
     // static cast so the number is not simple integer - shifting would go out of range
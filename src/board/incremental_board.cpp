@@ -0,0 +1,151 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "board/incremental_board.h"
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include <algorithm>
+#include <bit>
+
+// sums of heuristic values for every byte of the bitmap, byte i covers bits 8*i to 8*i+7
+struct WeightTable {
+    int16_t sums[8][256];
+};
+
+static constexpr WeightTable generate_weights() {
+    WeightTable table = {};
+    for (int byte = 0; byte < 8; ++byte) {
+        for (int bits = 0; bits < 256; ++bits) {
+            int sum = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                if (bits & (1 << bit)) sum += Board::heuristics_map[63 - (8 * byte + bit)];
+            }
+            table.sums[byte][bits] = static_cast<int16_t>(sum);
+        }
+    }
+    return table;
+}
+
+static constexpr WeightTable weight_table = generate_weights();
+
+template <class BoardT>
+ALWAYS_INLINE int IncrementalBoard<BoardT>::weight(uint64_t bitmap) {
+    // table lookups have no branches, number of flipped pieces is hard to predict
+    int sum = 0;
+    for (int byte = 0; byte < 8; ++byte) {
+        sum += weight_table.sums[byte][(bitmap >> (8 * byte)) & 0xff];
+    }
+    return sum;
+}
+
+template <class BoardT>
+IncrementalBoard<BoardT>::IncrementalBoard() : BoardT(), position(0) {}
+
+template <class BoardT>
+IncrementalBoard<BoardT>::IncrementalBoard(const Board &board) : BoardT(board) {
+    position = weight(this->white_bitmap) - weight(this->black_bitmap);
+}
+
+template <class BoardT>
+ALWAYS_INLINE void IncrementalBoard<BoardT>::play_move(bool color, uint64_t move) {
+    apply_move(color, move, this->flips(color, move));
+}
+
+template <class BoardT>
+ALWAYS_INLINE void IncrementalBoard<BoardT>::apply_move(bool color, uint64_t move, uint64_t flips) {
+    BoardT::apply_move(color, move, flips);
+    // move square is gained, flipped squares are lost by the opponent and gained by the player
+    int delta = Board::heuristics_map[std::countl_zero(move)] + 2 * weight(flips);
+    position += color ? delta : -delta;
+}
+
+template <class BoardT>
+ALWAYS_INLINE void IncrementalBoard<BoardT>::undo_move(bool color, uint64_t move, uint64_t flips) {
+    BoardT::undo_move(color, move, flips);
+    int delta = Board::heuristics_map[std::countl_zero(move)] + 2 * weight(flips);
+    position -= color ? delta : -delta;
+}
+
+template <class BoardT>
+ALWAYS_INLINE int IncrementalBoard<BoardT>::rate_board() const {
+    uint64_t white_moves, black_moves;
+    this->find_moves_both(white_moves, black_moves);
+    int moves_delta = std::popcount(white_moves) - std::popcount(black_moves);
+    return position + 10 * moves_delta;
+}
+
+template <class BoardT>
+ALWAYS_INLINE int IncrementalBoard<BoardT>::position_score() const {
+    return position;
+}
+
+template <class BoardT>
+ALWAYS_INLINE int IncrementalBoard<BoardT>::rate_children(bool color, uint64_t moves) const {
+    // there are at most 60 empty squares, so every batch fits after padding
+    alignas(64) uint64_t whites[64];
+    alignas(64) uint64_t blacks[64];
+    int positions[64];
+    int moves_delta[64];
+
+    int count = 0;
+    while (moves) {
+        uint64_t move = moves & -moves;
+        moves ^= move;
+        uint64_t flips = this->flips(color, move);
+        int delta = Board::heuristics_map[std::countl_zero(move)] + 2 * weight(flips);
+        if (color) {
+            whites[count] = this->white_bitmap | move | flips;
+            blacks[count] = this->black_bitmap ^ flips;
+            positions[count] = position + delta;
+        }
+        else {
+            whites[count] = this->white_bitmap ^ flips;
+            blacks[count] = this->black_bitmap | move | flips;
+            positions[count] = position - delta;
+        }
+        count++;
+    }
+
+    // padding boards are empty, their results are ignored
+    int padded = (count + BoardT::BATCH_WIDTH - 1) & ~(BoardT::BATCH_WIDTH - 1);
+    for (int i = count; i < padded; ++i) {
+        whites[i] = 0;
+        blacks[i] = 0;
+    }
+    BoardT::mobility_batch(whites, blacks, padded, moves_delta);
+
+    int best = positions[0] + 10 * moves_delta[0];
+    for (int i = 1; i < count; ++i) {
+        int score = positions[i] + 10 * moves_delta[i];
+        best = color ? std::max(best, score) : std::min(best, score);
+    }
+    return best;
+}
+
+// search state is compiled once for every board backend, see CMakeLists.txt
+template class IncrementalBoard<BOARD_BACKEND>;
@@ -0,0 +1,178 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "board/pattern_board.h"
+#include "board/pattern_eval.h"
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include <bit>
+#include <utility>
+
+// base-3 value of every extracted bit pattern of up to 10 squares,
+// index of an instance is then ternary[white] + 2 * ternary[black]
+struct TernaryTable {
+    uint16_t values[1024];
+};
+
+static constexpr TernaryTable generate_ternary() {
+    TernaryTable table = {};
+    for (int bits = 0; bits < 1024; ++bits) {
+        int digit = 1;
+        for (int i = 0; i < 10; ++i) {
+            if ((bits >> i) & 1) table.values[bits] += digit;
+            digit *= 3;
+        }
+    }
+    return table;
+}
+
+static constexpr TernaryTable ternary = generate_ternary();
+
+// all 8 symmetric images of the bitmap, indexed by symmetry bits of PatternEval::Family
+static ALWAYS_INLINE void symmetries(uint64_t bitmap, uint64_t *images) {
+    uint64_t transposed = Board::transpose(bitmap);
+    images[0] = bitmap;
+    images[2] = Board::flip_vertical(bitmap);
+    images[4] = transposed;
+    images[6] = Board::flip_vertical(transposed);
+    for (int i = 0; i < 8; i += 2) {
+        images[i + 1] = Board::mirror_horizontal(images[i]);
+    }
+}
+
+// extraction of a constant mask for backends without fast extract(),
+// squares lying in different columns are gathered to the top byte by one multiplication,
+// other masks are split into runs of neighbouring bits, which are shifted into place
+struct GatherPlan {
+    bool multiply;
+    int run_count;
+    int shifts[8];
+    uint64_t masks[8];
+    int positions[8];
+};
+
+static constexpr GatherPlan plan_gather(uint64_t mask) {
+    GatherPlan plan = {};
+    uint8_t columns = 0;
+    int last_column = -1;
+    bool ascending = true;
+    for (int bit = 0; bit < 64; ++bit) {
+        if (!((mask >> bit) & 1)) continue;
+        // extract keeps bits in the order of the mask, so their columns have to grow with them
+        if (bit % 8 <= last_column) ascending = false;
+        last_column = bit % 8;
+        columns |= 1 << (bit % 8);
+    }
+    // multiplication moves every bit to its column, the columns have to be
+    // the lowest ones in ascending order to match the other extract paths
+    int count = std::popcount(mask);
+    plan.multiply = ascending && columns == (1 << count) - 1;
+
+    int position = 0;
+    for (int bit = 0; bit < 64; ) {
+        if (!((mask >> bit) & 1)) {
+            bit++;
+            continue;
+        }
+        int length = 0;
+        while (bit + length < 64 && ((mask >> (bit + length)) & 1)) length++;
+        plan.shifts[plan.run_count] = bit;
+        plan.masks[plan.run_count] = (static_cast<uint64_t>(1) << length) - 1;
+        plan.positions[plan.run_count] = position;
+        plan.run_count++;
+        position += length;
+        bit += length;
+    }
+    return plan;
+}
+
+template <class BoardT, uint64_t mask>
+static ALWAYS_INLINE uint64_t extract(uint64_t bitmap) {
+    if constexpr (BoardT::FAST_EXTRACT) {
+        return BoardT::extract(bitmap, mask);
+    }
+    else {
+        constexpr GatherPlan plan = plan_gather(mask);
+        if constexpr (plan.multiply) {
+            return ((bitmap & mask) * 0x0101010101010101) >> 56;
+        }
+        else {
+            uint64_t result = 0;
+            for (int i = 0; i < plan.run_count; ++i) {
+                result |= ((bitmap >> plan.shifts[i]) & plan.masks[i]) << plan.positions[i];
+            }
+            return result;
+        }
+    }
+}
+
+// sum of weights of all instances of one family
+template <class BoardT, int f>
+static ALWAYS_INLINE int family_score(const uint64_t *whites, const uint64_t *blacks, const int16_t *table) {
+    constexpr PatternEval::Family family = PatternEval::families[f];
+    int score = 0;
+    for (int i = 0; i < family.instance_count; ++i) {
+        int symmetry = family.symmetries[i];
+        int index = ternary.values[extract<BoardT, family.mask>(whites[symmetry])];
+        index += 2 * ternary.values[extract<BoardT, family.mask>(blacks[symmetry])];
+        score += table[family.offset + index];
+    }
+    return score;
+}
+
+// families are expanded at compile time, so every mask is a constant
+template <class BoardT, int... f>
+static ALWAYS_INLINE int pattern_score(const uint64_t *whites, const uint64_t *blacks, const int16_t *table, std::integer_sequence<int, f...>) {
+    return (family_score<BoardT, f>(whites, blacks, table) + ...);
+}
+
+template <class BoardT>
+ALWAYS_INLINE int PatternBoard<BoardT>::rate_board() const {
+    uint64_t whites[8], blacks[8];
+    symmetries(this->white_bitmap, whites);
+    symmetries(this->black_bitmap, blacks);
+
+    int phase = PatternEval::phase(std::popcount(this->white_bitmap | this->black_bitmap));
+    const int16_t *table = PatternEval::weights() + phase * PatternEval::PHASE_SIZE;
+    int score = pattern_score<BoardT>(whites, blacks, table, std::make_integer_sequence<int, PatternEval::FAMILY_COUNT>());
+
+    uint64_t white_stable, black_stable;
+    this->find_stable(white_stable, black_stable);
+    score += table[PatternEval::STABILITY_OFFSET] * (std::popcount(white_stable) - std::popcount(black_stable));
+    uint64_t white_frontier, black_frontier, white_potential, black_potential;
+    this->find_frontier(white_frontier, black_frontier, white_potential, black_potential);
+    score += table[PatternEval::FRONTIER_OFFSET] * (std::popcount(white_frontier) - std::popcount(black_frontier));
+    score += table[PatternEval::POTENTIAL_OFFSET] * (std::popcount(white_potential) - std::popcount(black_potential));
+
+    if (score > PatternEval::MAX_SCORE) return PatternEval::MAX_SCORE;
+    if (score < -PatternEval::MAX_SCORE) return -PatternEval::MAX_SCORE;
+    return score;
+}
+
+// evaluator is compiled once for every board backend, see CMakeLists.txt
+template class PatternBoard<BOARD_BACKEND>;
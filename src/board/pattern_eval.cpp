@@ -0,0 +1,186 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "board/pattern_eval.h"
+#include "board/board.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+// weights of all phases, empty until load() succeeds
+static std::vector<int16_t> weight_table;
+
+// every family has 3^squares weights, offsets are written out in the header
+static constexpr bool check_offsets() {
+    int offset = 0;
+    for (const PatternEval::Family &family : PatternEval::families) {
+        if (family.offset != offset) return false;
+        int size = 1;
+        for (int i = 0; i < std::popcount(family.mask); ++i) size *= 3;
+        offset += size;
+    }
+    return offset == PatternEval::STABILITY_OFFSET
+        && PatternEval::FRONTIER_OFFSET == offset + 1
+        && PatternEval::POTENTIAL_OFFSET == offset + 2
+        && PatternEval::PHASE_SIZE == offset + PatternEval::FEATURE_COUNT;
+}
+static_assert(check_offsets(), "pattern family offsets do not match the masks");
+
+static constexpr bool check_instances() {
+    int count = 0;
+    for (const PatternEval::Family &family : PatternEval::families) {
+        count += family.instance_count;
+    }
+    return count == PatternEval::INSTANCE_COUNT;
+}
+static_assert(check_instances(), "pattern instance count does not match the families");
+
+// reads little-endian unsigned integer of the given size
+static bool read_uint(std::FILE *file, int bytes, uint32_t &value) {
+    unsigned char buffer[4];
+    if (std::fread(buffer, 1, bytes, file) != static_cast<size_t>(bytes)) return false;
+    value = 0;
+    for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | buffer[i];
+    return true;
+}
+
+bool PatternEval::load(const char *path) {
+    std::FILE *file = std::fopen(path, "rb");
+    if (!file) {
+        std::cout << "Could not open weights file " << path << ".\n";
+        return false;
+    }
+
+    // header has to describe the same layout as the one compiled in
+    char magic[4];
+    uint32_t version, phases, phase_size;
+    bool valid = std::fread(magic, 1, 4, file) == 4 && std::equal(magic, magic + 4, FILE_MAGIC);
+    valid = valid && read_uint(file, 4, version) && version == FILE_VERSION;
+    valid = valid && read_uint(file, 4, phases) && phases == PHASES;
+    valid = valid && read_uint(file, 4, phase_size) && phase_size == PHASE_SIZE;
+    if (!valid) {
+        std::cout << "File " << path << " is not a compatible weights file.\n";
+        std::fclose(file);
+        return false;
+    }
+
+    std::vector<int16_t> table(PHASES * PHASE_SIZE);
+    for (int16_t &weight : table) {
+        uint32_t value;
+        if (!read_uint(file, 2, value)) {
+            std::cout << "Weights file " << path << " is truncated.\n";
+            std::fclose(file);
+            return false;
+        }
+        weight = static_cast<int16_t>(static_cast<uint16_t>(value));
+    }
+    std::fclose(file);
+
+    weight_table = std::move(table);
+    return true;
+}
+
+// writes little-endian unsigned integer of the given size
+static bool write_uint(std::FILE *file, int bytes, uint32_t value) {
+    unsigned char buffer[4];
+    for (int i = 0; i < bytes; ++i) buffer[i] = (value >> (8 * i)) & 0xff;
+    return std::fwrite(buffer, 1, bytes, file) == static_cast<size_t>(bytes);
+}
+
+bool PatternEval::save(const char *path, const int16_t *weights) {
+    std::FILE *file = std::fopen(path, "wb");
+    if (!file) {
+        std::cout << "Could not create weights file " << path << ".\n";
+        return false;
+    }
+    bool valid = std::fwrite(FILE_MAGIC, 1, 4, file) == 4;
+    valid = valid && write_uint(file, 4, FILE_VERSION);
+    valid = valid && write_uint(file, 4, PHASES);
+    valid = valid && write_uint(file, 4, PHASE_SIZE);
+    for (int i = 0; valid && i < PHASES * PHASE_SIZE; ++i) {
+        valid = write_uint(file, 2, static_cast<uint16_t>(weights[i]));
+    }
+    valid = std::fclose(file) == 0 && valid;
+    if (!valid) {
+        std::cout << "Could not write weights file " << path << ".\n";
+    }
+    return valid;
+}
+
+const int16_t *PatternEval::weights() {
+    return weight_table.empty() ? nullptr : weight_table.data();
+}
+
+int PatternEval::phase(int discs) {
+    // phases split the 60 moves of the game evenly
+    return std::max(discs - 4, 0) * PHASES / 61;
+}
+
+void PatternEval::indices(uint64_t white, uint64_t black, int *indices) {
+    int instance = 0;
+    for (const Family &family : families) {
+        for (int i = 0; i < family.instance_count; ++i) {
+            int symmetry = family.symmetries[i];
+            int index = 0;
+            int digit = 1;
+            // squares are read from the lowest bit of the mask, same order as bit extraction
+            for (int bit = 0; bit < 64; ++bit) {
+                if (!((family.mask >> bit) & 1)) continue;
+                // square of the transformed board mapped back to the original board
+                int row = (63 - bit) / 8;
+                int col = (63 - bit) % 8;
+                if (symmetry & 1) col = 7 - col;
+                if (symmetry & 2) row = 7 - row;
+                if (symmetry & 4) std::swap(row, col);
+                int square = 63 - (row * 8 + col);
+                if ((white >> square) & 1) index += digit;
+                else if ((black >> square) & 1) index += 2 * digit;
+                digit *= 3;
+            }
+            indices[instance++] = family.offset + index;
+        }
+    }
+}
+
+void PatternEval::features(uint64_t white, uint64_t black, int *features) {
+    Board board(white, black);
+    uint64_t white_stable, black_stable;
+    board.find_stable(white_stable, black_stable);
+    uint64_t white_frontier, black_frontier, white_potential, black_potential;
+    board.find_frontier(white_frontier, black_frontier, white_potential, black_potential);
+    features[0] = std::popcount(white_stable) - std::popcount(black_stable);
+    features[1] = std::popcount(white_frontier) - std::popcount(black_frontier);
+    features[2] = std::popcount(white_potential) - std::popcount(black_potential);
+}
+
+int PatternEval::reference(uint64_t white, uint64_t black) {
+    const int16_t *table = weights() + phase(std::popcount(white | black)) * PHASE_SIZE;
+    int instances[INSTANCE_COUNT];
+    indices(white, black, instances);
+    int score = 0;
+    for (int index : instances) {
+        score += table[index];
+    }
+    int values[FEATURE_COUNT];
+    features(white, black, values);
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        score += table[STABILITY_OFFSET + i] * values[i];
+    }
+    return std::clamp(score, -MAX_SCORE, MAX_SCORE);
+}
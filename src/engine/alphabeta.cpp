@@ -16,20 +16,32 @@
 */
 
 #include "engine/alphabeta.h"
-#include <iostream>
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include "board/bitplane_board.h"
+#include "board/incremental_board.h"
+#include "board/pattern_board.h"
+#include <chrono>
 
 // initialize stats counters and select move order
-Alphabeta::Alphabeta(Engine::Settings settings) : total_heuristic_count(0), total_state_count(0), move_order(settings.order) {
+template <class BoardT, template <class> class EvalT>
+Alphabeta<BoardT, EvalT>::Alphabeta(Engine::Settings settings) : move_order(settings.order), eval_cache(settings.eval_cache_size) {
     this->settings = settings;
 }
 
-uint64_t Alphabeta::search(Board state, bool color) {
+template <class BoardT, template <class> class EvalT>
+uint64_t Alphabeta<BoardT, EvalT>::search(Board board, bool color) {
+    // engine works with the board backend it was instantiated for
+    State state(board);
+
     // transposition table must be empty before calculation of best move, otherwise results would be affected
     transposition_table.clear();
     
     // reset stats counters
-    last_heuristic_count = 0;
-    last_state_count = 0;
+    last_stats = SearchStats();
+    auto start = std::chrono::steady_clock::now();
     
     uint64_t best_move = 0;
     uint64_t possible_moves = state.find_moves(color);
@@ -38,15 +50,15 @@ uint64_t Alphabeta::search(Board state, bool color) {
     int beta = 1000;
     int best_eval = 0;
     int eval;
-    Board next;
     
     if (color == true && possible_moves != 0) {
         best_eval = -1000;
         for (uint64_t move : move_order) {
             if (possible_moves & move) {
-                next = state;
-                next.play_move(color, move);
-                eval = alphabeta(next, settings.search_depth-1, !color, alpha, beta, false);
+                uint64_t flips = state.flips(color, move);
+                state.apply_move(color, move, flips);
+                eval = alphabeta(state, settings.search_depth-1, !color, alpha, beta, false);
+                state.undo_move(color, move, flips);
                 if (eval > best_eval) {
                     best_move = move;
                     best_eval = eval;
@@ -59,9 +71,10 @@ uint64_t Alphabeta::search(Board state, bool color) {
         best_eval = 1000;
         for (uint64_t move : move_order) {
             if ((possible_moves & move) != 0) {
-                next = state;
-                next.play_move(color, move);
-                eval = alphabeta(next, settings.search_depth-1, !color, alpha, beta, false);
+                uint64_t flips = state.flips(color, move);
+                state.apply_move(color, move, flips);
+                eval = alphabeta(state, settings.search_depth-1, !color, alpha, beta, false);
+                state.undo_move(color, move, flips);
                 if (eval < best_eval) {
                     best_move = move;
                     best_eval = eval;
@@ -71,24 +84,46 @@ uint64_t Alphabeta::search(Board state, bool color) {
         }
     }
 
-    std::cout << "Went through " << last_state_count     << " states.\n";
-    std::cout << "Analyzed     " << last_heuristic_count << " states.\n";
-    std::cout << best_eval << '\n';
-    total_heuristic_count += last_heuristic_count;
-    total_state_count += last_state_count;
+    last_pv.length = best_move != 0;
+    last_pv.moves[0] = best_move;
+    last_scores.color = color;
+    last_scores.count = best_move != 0;
+    last_scores.moves[0] = {best_move, best_eval, true};
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (!settings.quiet) last_stats.print(elapsed.count(), best_eval);
+    total_stats += last_stats;
     return best_move;
 }
 
-int Alphabeta::alphabeta(Board state, int depth, bool cur_color, int alpha, int beta, bool end_board) {
+template <class BoardT, template <class> class EvalT>
+const SearchStats &Alphabeta<BoardT, EvalT>::get_last_stats() const {
+    return last_stats;
+}
+
+template <class BoardT, template <class> class EvalT>
+const PrincipalVariation &Alphabeta<BoardT, EvalT>::get_last_pv() const {
+    return last_pv;
+}
+
+template <class BoardT, template <class> class EvalT>
+const RootScores &Alphabeta<BoardT, EvalT>::get_last_scores() const {
+    return last_scores;
+}
+
+template <class BoardT, template <class> class EvalT>
+int Alphabeta<BoardT, EvalT>::alphabeta(State &state, int depth, bool cur_color, int alpha, int beta, bool end_board) {
     int init_alpha = alpha;
     int init_beta = beta;
     uint64_t hash = 0;
-    last_state_count++;
+    last_stats.state_count++;
     
     // reach max depth
     if (depth == 0) {
-        last_heuristic_count++;
-        return state.rate_board();
+        last_stats.heuristic_count++;
+        if (!eval_cache.enabled()) return state.rate_board();
+        // leaves reached by different move orders are looked up in the evaluation cache
+        return eval_cache.rate_board(state, last_stats);
     }
     
     // check if state was already calculated
@@ -96,9 +131,13 @@ int Alphabeta::alphabeta(Board state, int depth, bool cur_color, int alpha, int
     // too large at lower levels, it is then faster
     // to just calculate the score again
     if (settings.transposition_enable && depth > 2) {
-        hash = state.hash();
-        int score = transposition_table.get(hash, alpha, beta);
+        hash = settings.canonical_tt ? state.canonical_hash() : state.hash();
+        // alphabeta keeps the static move order, stored moves are not used
+        uint64_t hash_move;
+        int score = transposition_table.get(hash, alpha, beta, depth, hash_move);
+        last_stats.tt_probe_count++;
         if (score != TranspositionTable::NOT_FOUND) {
+            last_stats.tt_hit_count++;
             return score;
         }
     }
@@ -121,17 +160,18 @@ int Alphabeta::alphabeta(Board state, int depth, bool cur_color, int alpha, int
     }
 
     int best_eval;
-    Board next;
     if (cur_color == true) {
         best_eval = -1000;
         for (uint64_t move : move_order) {
             if (possible_moves & move) {
-                next = state;
-                next.play_move(cur_color, move);
-                eval = alphabeta(next, depth-1, !cur_color, alpha, beta, false);
+                uint64_t flips = state.flips(cur_color, move);
+                state.apply_move(cur_color, move, flips);
+                eval = alphabeta(state, depth-1, !cur_color, alpha, beta, false);
+                state.undo_move(cur_color, move, flips);
                 best_eval = std::max(eval, best_eval);
                 alpha = std::max(eval, alpha);
                 if (beta <= alpha) {
+                    last_stats.cutoff_count++;
                     break;
                 }
             }
@@ -141,12 +181,14 @@ int Alphabeta::alphabeta(Board state, int depth, bool cur_color, int alpha, int
         best_eval = 1000;
         for (uint64_t move : move_order) {
             if (possible_moves & move) {
-                next = state;
-                next.play_move(cur_color, move);
-                eval = alphabeta(next, depth-1, !cur_color, alpha, beta, false);
+                uint64_t flips = state.flips(cur_color, move);
+                state.apply_move(cur_color, move, flips);
+                eval = alphabeta(state, depth-1, !cur_color, alpha, beta, false);
+                state.undo_move(cur_color, move, flips);
                 best_eval = std::min(eval, best_eval);
                 beta = std::min(eval, beta);
                 if (beta <= alpha) {
+                    last_stats.cutoff_count++;
                     break;
                 }
             }
@@ -155,8 +197,15 @@ int Alphabeta::alphabeta(Board state, int depth, bool cur_color, int alpha, int
     
     // save the score for future
     if (settings.transposition_enable && depth > 2) {
-        transposition_table.insert(hash, best_eval, init_alpha, init_beta);
+        transposition_table.insert(hash, best_eval, init_alpha, init_beta, depth, 0);
     }
     
     return best_eval;
 }
+
+// engine is compiled once for every board backend, see CMakeLists.txt,
+// and for every evaluator of the backend
+template class Alphabeta<BOARD_BACKEND, TableEval>;
+template class Alphabeta<BOARD_BACKEND, IncrementalBoard>;
+template class Alphabeta<BOARD_BACKEND, BitplaneBoard>;
+template class Alphabeta<BOARD_BACKEND, PatternBoard>;
@@ -0,0 +1,57 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "engine/eval_cache.h"
+#include <bit>
+
+// lower 16 bits of an entry hold the score, the rest is the key
+static constexpr uint64_t SCORE_MASK = 0xffff;
+
+EvalCache::EvalCache(int size) : mask(0) {
+    if (size > 0) {
+        uint64_t count = std::bit_floor(static_cast<uint64_t>(size) * 1024 * 1024 / sizeof(uint64_t));
+        entries = std::make_unique<std::atomic<uint64_t>[]>(count);
+        mask = count - 1;
+    }
+}
+
+EvalCache::~EvalCache() {}
+
+ALWAYS_INLINE bool EvalCache::enabled() const {
+    return entries != nullptr;
+}
+
+ALWAYS_INLINE bool EvalCache::get(uint64_t hash, int &score) const {
+    uint64_t entry = entries[hash & mask].load(std::memory_order_relaxed);
+    if ((entry & ~SCORE_MASK) != (hash & ~SCORE_MASK)) return false;
+    score = static_cast<int16_t>(entry & SCORE_MASK);
+    return true;
+}
+
+ALWAYS_INLINE void EvalCache::insert(uint64_t hash, int score) {
+    uint64_t entry = (hash & ~SCORE_MASK) | (static_cast<uint16_t>(score) & SCORE_MASK);
+    entries[hash & mask].store(entry, std::memory_order_relaxed);
+}
@@ -16,25 +16,207 @@
 */
 
 #include "engine/negascout.h"
-#include <iostream>
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include "board/bitplane_board.h"
+#include "board/incremental_board.h"
+#include "board/pattern_board.h"
 #include <bit>
 #include <vector>
 #include <thread>
+#include <chrono>
+
+// stability cutoff of the endgame search
+//
+// when the rest of the game fits into the remaining depth, every leaf is a finished game
+// scored 999, 0 or -999, so a color with more than half of the board stable has already won,
+// score is set and true returned if the bounds of the result decide the node
+template <class State>
+static bool stability_cutoff(const State &state, int depth, int alpha, int beta, int &score) {
+    if (depth <= 64 - std::popcount(state.white() | state.black())) return false;
+
+    uint64_t white_stable, black_stable;
+    state.find_stable(white_stable, black_stable);
+    int white_count = std::popcount(white_stable);
+    int black_count = std::popcount(black_stable);
+    int lower = white_count > 32 ? 999 : (white_count == 32 ? 0 : -999);
+    int upper = black_count > 32 ? -999 : (black_count == 32 ? 0 : 999);
+    if (lower >= beta) {
+        score = lower;
+        return true;
+    }
+    if (upper <= alpha || lower == upper) {
+        score = upper;
+        return true;
+    }
+    return false;
+}
+
+// key of the transposition table, symmetry is set to the transformation of the board
+// into its canonical form, stored moves are kept in the canonical orientation
+template <class State>
+static uint64_t tt_key(const State &state, bool canonical, int &symmetry) {
+    if (!canonical) {
+        symmetry = 0;
+        return state.hash();
+    }
+    Board board;
+    symmetry = state.canonical(board);
+    return board.hash();
+}
+
+// upper bound of legal moves in one position
+static constexpr int MAX_MOVES = 64;
+
+// corners are never reduced, they are often the best move even late in the order
+static constexpr uint64_t CORNERS = 0x8100000000000081;
+
+// fills moves in the order they are searched and returns their count
+//
+// first_move (hash move) goes first if it is legal
+//
+// static move order is used close to the horizon, from fastest_first_depth up (if enabled)
+// children are sorted by mobility of the opponent, moves leaving the fewest replies are
+// searched first (fastest-first), they are often the best ones and their subtrees are
+// the smallest, moves with the same mobility keep the static order
+template <class BoardT>
+static int order_moves(const BoardT &board, bool color, uint64_t possible_moves, int depth, int fastest_first_depth,
+                       const Move_order &move_order, uint64_t first_move, uint64_t *moves) {
+    int count = 0;
+    // hash move is searched before all others, it is ignored if it is not legal (hash collision)
+    if (possible_moves & first_move) {
+        moves[count++] = first_move;
+        possible_moves ^= first_move;
+    }
+    int ordered = count;
+    if (fastest_first_depth == 0 || depth < fastest_first_depth) {
+        for (uint64_t move : move_order) {
+            if (possible_moves & move) moves[count++] = move;
+        }
+        return count;
+    }
+
+    int replies[MAX_MOVES];
+    for (uint64_t move : move_order) {
+        if (possible_moves & move) {
+            BoardT child = board;
+            child.play_move(color, move);
+            int reply_count = std::popcount(child.find_moves(!color));
+            // insertion sort, the list is short and already in static order
+            int i = count++;
+            while (i > ordered && replies[i - 1] > reply_count) {
+                replies[i] = replies[i - 1];
+                moves[i] = moves[i - 1];
+                --i;
+            }
+            replies[i] = reply_count;
+            moves[i] = move;
+        }
+    }
+    return count;
+}
+
+// best move of a position close to the horizon, the specialized routines do not store moves
+// in the transposition table, search(child, depth) returns the full window score of the child,
+// ties are resolved by the move order the same way as in the search
+template <class State, class Search>
+static uint64_t pv_move(State &state, bool color, int depth, uint64_t possible_moves, const Move_order &move_order, Search search) {
+    uint64_t best_move = 0;
+    int best_eval = 0;
+    for (uint64_t move : move_order) {
+        if (possible_moves & move) {
+            uint64_t flips = state.flips(color, move);
+            state.apply_move(color, move, flips);
+            int eval = search(state, depth - 1);
+            state.undo_move(color, move, flips);
+            if (best_move == 0 || (color ? eval > best_eval : eval < best_eval)) {
+                best_move = move;
+                best_eval = eval;
+            }
+        }
+    }
+    return best_move;
+}
+
+// follows the line from its starting position until the searched position is reached,
+// rest of the line is passed to store(position, move) and its first move is returned,
+// 0 is returned if the position is not on the line
+template <class State, class Store>
+static uint64_t seed_line(const State &state, bool color, Board board, bool at_turn, const PrincipalVariation &line, Store store) {
+    int i = 0;
+    while (i < line.length && !(board.white() == state.white() && board.black() == state.black() && at_turn == color)) {
+        if (line.moves[i] != 0) board.play_move(at_turn, line.moves[i]);
+        at_turn = !at_turn;
+        ++i;
+    }
+    if (i == line.length) return 0;
+
+    uint64_t first_move = line.moves[i];
+    for (; i < line.length; ++i) {
+        if (line.moves[i] != 0) {
+            store(board, line.moves[i]);
+            board.play_move(at_turn, line.moves[i]);
+        }
+        at_turn = !at_turn;
+    }
+    return first_move;
+}
 
 // initialize stats counters and select move order
-Negascout::Negascout(Engine::Settings settings) : total_heuristic_count(0), total_state_count(0), move_order(settings.order) {
+template <class BoardT, template <class> class EvalT>
+Negascout<BoardT, EvalT>::Negascout(Engine::Settings settings) : move_order(settings.order), eval_cache(settings.eval_cache_size),
+    reductions(settings.lmr_depth, settings.lmr_moves, settings.lmr_reduction) {
     this->settings = settings;
 }
 
-uint64_t Negascout::search(Board state, bool color) {
-    // transposition table must be empty before calculation of best move, otherwise results would be affected
-    transposition_table.clear();
+template <class BoardT, template <class> class EvalT>
+uint64_t Negascout<BoardT, EvalT>::search(Board board, bool color) {
+    // engine works with the board backend it was instantiated for
+    State state(board);
+
+    // scores of other searches are valid only for the same depth, so the table is emptied,
+    // table filled by pondering on the time of the opponent is kept
+    if (!pondered) transposition_table.clear();
+    pondered = false;
+    // pondering is stopped only after the opponent moved, it may have finished before
+    stopped.store(false, std::memory_order_relaxed);
     
     // reset stats counters
-    last_heuristic_count = 0;
-    last_state_count = 0;
+    last_stats = SearchStats();
+    auto start = std::chrono::steady_clock::now();
 
-    uint64_t best_move = 0;
+    // line predicted by the last search is searched first
+    uint64_t best_move = seed_pv(state, color);
+    int best_eval = 0;
+
+    // iterative deepening, every iteration leaves the hash moves of its line for the next one,
+    // iterations keep parity of the search depth, scores of odd and even depths differ
+    // too much (odd-even effect) for the shallower line to predict the deeper one,
+    // line predicted by the last search comes from deeper search than the shallow iterations
+    bool deepen = settings.iterative_deepening && best_move == 0;
+    int first_depth = deepen ? 2 - settings.search_depth % 2 : settings.search_depth;
+    for (int depth = first_depth; depth <= settings.search_depth; depth += 2) {
+        best_eval = search_root(state, color, depth, best_move, best_move);
+        collect_pv(state, color, depth, best_move, last_pv);
+        if (!settings.quiet) last_pv.print(depth, best_eval);
+    }
+    pv_board = board;
+    pv_color = color;
+    last_scores.color = color;
+    last_scores.count = best_move != 0;
+    last_scores.moves[0] = {best_move, best_eval, true};
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (!settings.quiet) last_stats.print(elapsed.count(), best_eval);
+    total_stats += last_stats;
+    return best_move;
+}
+
+template <class BoardT, template <class> class EvalT>
+int Negascout<BoardT, EvalT>::search_root(State &state, bool color, int depth, uint64_t first_move, uint64_t &best_move) {
+    best_move = 0;
     uint64_t possible_moves = state.find_moves(color);
 
     int alpha = -1000;
@@ -42,93 +224,257 @@ uint64_t Negascout::search(Board state, bool color) {
     int best_eval = 0;
     int eval;
     bool first = true;
-    Board next;
     
     if (color == true && possible_moves != 0) {
         best_eval = -1000;
-        for (uint64_t move : move_order) {
-            if (possible_moves & move) {
-                next = state;
-                next.play_move(color, move);
-                
-                if (first) { // run first move with whole window
-                    eval = negascout(next, settings.search_depth-1, !color, alpha, beta, false);
-                    first = false;
-                }
-                else {
-                    eval = negascout(next, settings.search_depth-1, !color, alpha, alpha+1, false); // minimize search window
-                    if (eval > alpha && eval < beta) { // if we missed the window and there might still be better move, rerun
-                        eval = negascout(next, settings.search_depth-1, !color, eval, beta, false);
-                    }
+        uint64_t moves[MAX_MOVES];
+        int move_count = order_moves<BoardT>(state, color, possible_moves, depth, settings.fastest_first_depth, move_order, first_move, moves);
+        for (int i = 0; i < move_count; ++i) {
+            uint64_t move = moves[i];
+            uint64_t flips = state.flips(color, move);
+            state.apply_move(color, move, flips);
+            
+            if (first) { // run first move with whole window
+                eval = negascout(state, depth-1, !color, alpha, beta, false);
+                first = false;
+            }
+            else {
+                eval = negascout(state, depth-1, !color, alpha, alpha+1, false); // minimize search window
+                if (eval > alpha && eval < beta) { // if we missed the window and there might still be better move, rerun
+                    eval = negascout(state, depth-1, !color, eval, beta, false);
                 }
+            }
+            state.undo_move(color, move, flips);
 
-                if (eval > best_eval) {
-                    best_move = move;
-                    best_eval = eval;
-                }
-                alpha = std::max(eval, alpha);
+            if (eval > best_eval) {
+                best_move = move;
+                best_eval = eval;
             }
+            alpha = std::max(eval, alpha);
         }
     }
     else if (color == false && possible_moves != 0) {
         best_eval = 1000;
+        uint64_t moves[MAX_MOVES];
+        int move_count = order_moves<BoardT>(state, color, possible_moves, depth, settings.fastest_first_depth, move_order, first_move, moves);
+        for (int i = 0; i < move_count; ++i) {
+            uint64_t move = moves[i];
+            uint64_t flips = state.flips(color, move);
+            state.apply_move(color, move, flips);
+            
+            if (first) { // run first move with whole window
+                eval = negascout(state, depth-1, !color, alpha, beta, false);
+                first = false;
+            }
+            else {
+                eval = negascout(state, depth-1, !color, beta-1, beta, false); // minimize search window
+                if (eval < beta && eval > alpha) { // if we missed the window and there might still be better move, rerun
+                    eval = negascout(state, depth-1, !color, alpha, eval, false);
+                }
+            }
+            state.undo_move(color, move, flips);
+
+            if (eval < best_eval) {
+                best_move = move;
+                best_eval = eval;
+            }
+            beta = std::min(eval, beta);
+        }
+    }
+
+    return best_eval;
+}
+
+template <class BoardT, template <class> class EvalT>
+void Negascout<BoardT, EvalT>::collect_pv(State state, bool color, int depth, uint64_t move, PrincipalVariation &pv) {
+    // search of the last plies is not counted in the statistics
+    SearchStats stats = last_stats;
+    pv.length = 0;
+    while (move != 0 && pv.length < PrincipalVariation::MAX_LENGTH) {
+        pv.moves[pv.length++] = move;
+        state.play_move(color, move);
+        color = !color;
+        if (--depth == 0) break;
+
+        uint64_t possible_moves = state.find_moves(color);
+        if (possible_moves == 0) {
+            // pass does not use up depth, the same way as in the search
+            possible_moves = state.find_moves(!color);
+            if (possible_moves == 0 || pv.length == PrincipalVariation::MAX_LENGTH) break;
+            pv.moves[pv.length++] = 0;
+            color = !color;
+        }
+
+        if (depth > 2) {
+            if (!settings.transposition_enable) break;
+            int symmetry;
+            uint64_t hash_move;
+            transposition_table.get(tt_key(state, settings.canonical_tt, symmetry), -1000, 1000, 0, hash_move);
+            // illegal move would be a hash collision
+            move = Board::untransform(hash_move, symmetry) & possible_moves;
+        }
+        else {
+            move = pv_move(state, color, depth, possible_moves, move_order, [&](State &child, int child_depth) {
+                return negascout(child, child_depth, !color, -1000, 1000, false);
+            });
+        }
+    }
+    last_stats = stats;
+}
+
+template <class BoardT, template <class> class EvalT>
+uint64_t Negascout<BoardT, EvalT>::seed_pv(const State &state, bool color) {
+    return seed_line(state, color, pv_board, pv_color, last_pv, [&](const Board &board, uint64_t move) {
+        if (!settings.transposition_enable) return;
+        int symmetry;
+        uint64_t hash = tt_key(board, settings.canonical_tt, symmetry);
+        transposition_table.insert_move(hash, Board::transform(move, symmetry));
+    });
+}
+
+template <class BoardT, template <class> class EvalT>
+const SearchStats &Negascout<BoardT, EvalT>::get_last_stats() const {
+    return last_stats;
+}
+
+template <class BoardT, template <class> class EvalT>
+const PrincipalVariation &Negascout<BoardT, EvalT>::get_last_pv() const {
+    return last_pv;
+}
+
+template <class BoardT, template <class> class EvalT>
+const RootScores &Negascout<BoardT, EvalT>::get_last_scores() const {
+    return last_scores;
+}
+
+template <class BoardT, template <class> class EvalT>
+void Negascout<BoardT, EvalT>::ponder(Board board, bool color) {
+    if (!settings.ponder) return;
+    State state(board);
+    transposition_table.clear();
+    last_stats = SearchStats();
+
+    // one ply deeper than the search depth, so the next search finds scores
+    // of all its children in the table if the opponent plays the predicted move
+    int ponder_depth = std::min(settings.search_depth + 1, 49);
+    uint64_t best_move = seed_pv(state, color);
+    for (int depth = 2 - ponder_depth % 2; depth <= ponder_depth; depth += 2) {
+        uint64_t move;
+        search_root(state, color, depth, best_move, move);
+        if (stopped.load(std::memory_order_relaxed)) break;
+        best_move = move;
+        // line is kept only if it was not cut short by stopping, it has to start from the stored root
+        PrincipalVariation pv;
+        collect_pv(state, color, depth, best_move, pv);
+        if (stopped.load(std::memory_order_relaxed)) break;
+        // line starting with the predicted move of the opponent is used by the next search
+        last_pv = pv;
+        pv_board = board;
+        pv_color = color;
+    }
+    pondered = true;
+}
+
+template <class BoardT, template <class> class EvalT>
+void Negascout<BoardT, EvalT>::stop_ponder() {
+    stopped.store(true, std::memory_order_relaxed);
+}
+
+template <class BoardT, template <class> class EvalT>
+template <int depth, bool cur_color>
+int Negascout<BoardT, EvalT>::frontier(State &state, int alpha, int beta, bool end_board) {
+    last_stats.state_count++;
+
+    if constexpr (depth == 0) {
+        last_stats.heuristic_count++;
+        if (!eval_cache.enabled()) return state.rate_board();
+        return eval_cache.rate_board(state, last_stats);
+    }
+    else {
+        // if there are no possible moves
+        uint64_t possible_moves = state.find_moves(cur_color);
+        if (possible_moves == 0) {
+            if (end_board) {
+                int count_white = state.count_white();
+                int count_black = state.count_black();
+                if (count_white > count_black) {return 999;}
+                else if (count_white < count_black) {return -999;}
+                else {return 0;}
+            }
+            return frontier<depth, !cur_color>(state, alpha, beta, true);
+        }
+
+        int best_eval = cur_color ? -1000 : 1000;
         for (uint64_t move : move_order) {
-            if ((possible_moves & move) != 0) {
-                next = state;
-                next.play_move(color, move);
-                
-                if (first) { // run first move with whole window
-                    eval = negascout(next, settings.search_depth-1, !color, alpha, beta, false);
-                    first = false;
+            if (possible_moves & move) {
+                uint64_t flips = state.flips(cur_color, move);
+                state.apply_move(cur_color, move, flips);
+                int eval = frontier<depth-1, !cur_color>(state, alpha, beta, false);
+                state.undo_move(cur_color, move, flips);
+
+                if constexpr (cur_color) {
+                    best_eval = std::max(eval, best_eval);
+                    alpha = std::max(eval, alpha);
                 }
                 else {
-                    eval = negascout(next, settings.search_depth-1, !color, beta-1, beta, false); // minimize search window
-                    if (eval < beta && eval > alpha) { // if we missed the window and there might still be better move, rerun
-                        eval = negascout(next, settings.search_depth-1, !color, alpha, eval, false);
-                    }
+                    best_eval = std::min(eval, best_eval);
+                    beta = std::min(eval, beta);
                 }
-
-                if (eval < best_eval) {
-                    best_move = move;
-                    best_eval = eval;
+                if (beta <= alpha) {
+                    last_stats.cutoff_count++;
+                    break;
                 }
-                beta = std::min(eval, beta);
             }
         }
+        return best_eval;
     }
-
-    std::cout << "Went through " << last_state_count     << " states.\n";
-    std::cout << "Analyzed     " << last_heuristic_count << " states.\n";
-    std::cout << best_eval << '\n';
-    total_heuristic_count += last_heuristic_count;
-    total_state_count += last_state_count;
-    return best_move;
 }
 
-int Negascout::negascout(Board state, int depth, bool cur_color, int alpha, int beta, bool end_board) {
+template <class BoardT, template <class> class EvalT>
+int Negascout<BoardT, EvalT>::negascout(State &state, int depth, bool cur_color, int alpha, int beta, bool end_board) {
+    // last plies are searched by the specialized routines, on the scalar backend as well
+    if (depth <= 2) {
+        if (cur_color) {
+            if (depth == 2) return frontier<2, true>(state, alpha, beta, end_board);
+            if (depth == 1) return frontier<1, true>(state, alpha, beta, end_board);
+            return frontier<0, true>(state, alpha, beta, end_board);
+        }
+        if (depth == 2) return frontier<2, false>(state, alpha, beta, end_board);
+        if (depth == 1) return frontier<1, false>(state, alpha, beta, end_board);
+        return frontier<0, false>(state, alpha, beta, end_board);
+    }
+
+    // aborted pondering, the score is never used
+    if (stopped.load(std::memory_order_relaxed)) return 0;
+
     int init_alpha = alpha;
     int init_beta = beta;
     uint64_t hash = 0;
-    last_state_count++;
-    
-    // reach max depth
-    if (depth == 0) {
-        last_heuristic_count++;
-        return state.rate_board();
-    }
+    int symmetry = 0;
+    uint64_t hash_move = 0;
+    last_stats.state_count++;
     
     // check if state was already calculated
     // overhead of using transposition table becomes
-    // too large at lower levels, it is then faster
-    // to just calculate the score again
-    if (settings.transposition_enable && depth > 2) {
-        hash = state.hash();
-        int score = transposition_table.get(hash, alpha, beta);
+    // too large at lower levels, so it is used only
+    // above the specialized routines
+    if (settings.transposition_enable) {
+        hash = tt_key(state, settings.canonical_tt, symmetry);
+        int score = transposition_table.get(hash, alpha, beta, depth, hash_move);
+        hash_move = Board::untransform(hash_move, symmetry);
+        last_stats.tt_probe_count++;
         if (score != TranspositionTable::NOT_FOUND) {
+            last_stats.tt_hit_count++;
             return score;
         }
     }
 
+    int bound;
+    if (stability_cutoff(state, depth, alpha, beta, bound)) {
+        last_stats.stability_cutoff_count++;
+        return bound;
+    }
+
     // if there are no possible moves
     uint64_t possible_moves = state.find_moves(cur_color);
     int eval;
@@ -146,195 +492,449 @@ int Negascout::negascout(Board state, int depth, bool cur_color, int alpha, int
         return eval;
     }
 
+    // internal iterative deepening, without a hash move the node is first searched
+    // to a reduced depth, its best move is then taken from the transposition table,
+    // the reduced search has to stay above the specialized routines, those store no moves
+    uint64_t iid_move = 0;
+    if (hash_move == 0 && settings.transposition_enable && settings.iid_depth != 0 && depth >= settings.iid_depth
+        && depth - settings.iid_reduction > 2) {
+        last_stats.iid_count++;
+        negascout(state, depth - settings.iid_reduction, cur_color, alpha, beta, end_board);
+        transposition_table.get(hash, alpha, beta, depth, hash_move);
+        hash_move = Board::untransform(hash_move, symmetry);
+        iid_move = hash_move;
+    }
+
     int best_eval;
+    uint64_t best_move = 0;
     bool first = true;
-    Board next;
     if (cur_color == true) {
         best_eval = -1000;
-        for (uint64_t move : move_order) {
-            if (possible_moves & move) {
-                next = state;
-                next.play_move(cur_color, move);
-                
-                if (first) { // run first move with whole window
-                    eval = negascout(next, depth-1, !cur_color, alpha, beta, false);
-                    first = false;
-                }
-                else {
-                    eval = negascout(next, depth-1, !cur_color, alpha, alpha+1, false); // minimize search window
-                    if (eval > alpha && eval < beta) { // if we missed the window and there might still be better move, rerun
-                        eval = negascout(next, depth-1, !cur_color, eval, beta, false);
+        uint64_t moves[MAX_MOVES];
+        int move_count = order_moves<BoardT>(state, cur_color, possible_moves, depth, settings.fastest_first_depth, move_order, hash_move, moves);
+        for (int i = 0; i < move_count; ++i) {
+            uint64_t move = moves[i];
+            uint64_t flips = state.flips(cur_color, move);
+            state.apply_move(cur_color, move, flips);
+            
+            if (first) { // run first move with whole window
+                eval = negascout(state, depth-1, !cur_color, alpha, beta, false);
+                first = false;
+            }
+            else {
+                // late moves are searched to reduced depth, full depth is needed only if they fail high
+                int reduction = move & CORNERS ? 0 : reductions.get(depth, i);
+                eval = negascout(state, depth-1-reduction, !cur_color, alpha, alpha+1, false); // minimize search window
+                if (reduction != 0) {
+                    last_stats.lmr_count++;
+                    if (eval > alpha) {
+                        last_stats.lmr_research_count++;
+                        eval = negascout(state, depth-1, !cur_color, alpha, alpha+1, false);
                     }
                 }
-
-                best_eval = std::max(eval, best_eval);
-                alpha = std::max(eval, alpha);
-                if (beta <= alpha) {
-                    break;
+                if (eval > alpha && eval < beta) { // if we missed the window and there might still be better move, rerun
+                    eval = negascout(state, depth-1, !cur_color, eval, beta, false);
                 }
             }
+            state.undo_move(cur_color, move, flips);
+
+            if (eval > best_eval) {
+                best_eval = eval;
+                best_move = move;
+            }
+            alpha = std::max(eval, alpha);
+            if (beta <= alpha) {
+                last_stats.cutoff_count++;
+                break;
+            }
         }
     }
     else {
         best_eval = 1000;
-        for (uint64_t move : move_order) {
-            if (possible_moves & move) {
-                next = state;
-                next.play_move(cur_color, move);
+        uint64_t moves[MAX_MOVES];
+        int move_count = order_moves<BoardT>(state, cur_color, possible_moves, depth, settings.fastest_first_depth, move_order, hash_move, moves);
+        for (int i = 0; i < move_count; ++i) {
+            uint64_t move = moves[i];
+            uint64_t flips = state.flips(cur_color, move);
+            state.apply_move(cur_color, move, flips);
 
-                if (first) { // run first move with whole window
-                    eval = negascout(next, depth-1, !cur_color, alpha, beta, false);
-                    first = false;
-                }
-                else {
-                    eval = negascout(next, depth-1, !cur_color, beta-1, beta, false); // minimize search window
-                    if (eval < beta && eval > alpha) { // if we missed the window and there might still be better move, rerun
-                        eval = negascout(next, depth-1, !cur_color, alpha, eval, false);
+            if (first) { // run first move with whole window
+                eval = negascout(state, depth-1, !cur_color, alpha, beta, false);
+                first = false;
+            }
+            else {
+                int reduction = move & CORNERS ? 0 : reductions.get(depth, i);
+                eval = negascout(state, depth-1-reduction, !cur_color, beta-1, beta, false); // minimize search window
+                if (reduction != 0) {
+                    last_stats.lmr_count++;
+                    if (eval < beta) {
+                        last_stats.lmr_research_count++;
+                        eval = negascout(state, depth-1, !cur_color, beta-1, beta, false);
                     }
                 }
-                
-                best_eval = std::min(eval, best_eval);
-                beta = std::min(eval, beta);
-                if (beta <= alpha) {
-                    break;
+                if (eval < beta && eval > alpha) { // if we missed the window and there might still be better move, rerun
+                    eval = negascout(state, depth-1, !cur_color, alpha, eval, false);
                 }
             }
+            state.undo_move(cur_color, move, flips);
+
+            if (eval < best_eval) {
+                best_eval = eval;
+                best_move = move;
+            }
+            beta = std::min(eval, beta);
+            if (beta <= alpha) {
+                last_stats.cutoff_count++;
+                break;
+            }
         }
     }
     
-    // save the score for future
-    if (settings.transposition_enable && depth > 2) {
-        transposition_table.insert(hash, best_eval, init_alpha, init_beta);
+    if (iid_move != 0) {
+        last_stats.iid_move_count++;
+        last_stats.iid_best_count += best_move == iid_move;
+    }
+
+    // scores of children may come from aborted pondering
+    if (stopped.load(std::memory_order_relaxed)) return 0;
+
+    // save the score for future, best move is kept only if it improved the bound,
+    // scores of the moves are not comparable otherwise and the old hash move is kept
+    if (settings.transposition_enable) {
+        bool improved = cur_color ? best_eval > init_alpha : best_eval < init_beta;
+        uint64_t stored_move = improved ? best_move : hash_move;
+        transposition_table.insert(hash, best_eval, init_alpha, init_beta, depth, Board::transform(stored_move, symmetry));
     }
 
     return best_eval;
 }
 
 // initialize stats counters and select move order
-NegascoutParallel::NegascoutParallel(Engine::Settings settings) : move_order(settings.order), manager(settings.thread_count) {
+template <class BoardT, template <class> class EvalT>
+NegascoutParallel<BoardT, EvalT>::NegascoutParallel(Engine::Settings settings) : move_order(settings.order), eval_cache(settings.eval_cache_size),
+    reductions(settings.lmr_depth, settings.lmr_moves, settings.lmr_reduction), manager(settings.thread_count) {
     this->settings = settings;
 }
 
-void NegascoutParallel::search_move(void *args) {
+template <class BoardT, template <class> class EvalT>
+int NegascoutParallel<BoardT, EvalT>::threshold(bool color) const {
+    if (best_count < settings.multipv) return color ? -1000 : 1000;
+    return best_scores[best_count - 1];
+}
+
+template <class BoardT, template <class> class EvalT>
+void NegascoutParallel<BoardT, EvalT>::add_score(bool color, int score) {
+    // score may have been beaten by other threads since the move loaded the threshold
+    int i = best_count;
+    if (best_count == settings.multipv) {
+        if (color ? score <= best_scores[i - 1] : score >= best_scores[i - 1]) return;
+        --i;
+    }
+    else {
+        ++best_count;
+    }
+    // insertion sort, the list is short
+    while (i > 0 && (color ? best_scores[i - 1] < score : best_scores[i - 1] > score)) {
+        best_scores[i] = best_scores[i - 1];
+        --i;
+    }
+    best_scores[i] = score;
+}
+
+template <class BoardT, template <class> class EvalT>
+void NegascoutParallel<BoardT, EvalT>::search_move(void *args) {
     SearchArg *args_ = (SearchArg*) args;
     int eval;
-    Board next = args_->state;
+    State next = args_->state;
     next.play_move(args_->cur_color, args_->move);
 
-    // load latest alpha beta values
+    // load latest score the move has to beat
     args_->obj->m.lock();
-    int alpha_loc = *(args_->alpha);
-    int beta_loc = *(args_->beta);
+    int bound = args_->obj->threshold(args_->cur_color);
     args_->obj->m.unlock();
 
-    // run the search
+    // run the search, until there are enough exact scores every move needs the whole window
+    bool exact = true;
     if (args_->cur_color) {
-            eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), alpha_loc, alpha_loc+1, false); // minimize search window
-            if (eval > alpha_loc && eval < beta_loc) { // if we missed the window and there might still be better move, rerun
-                eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), eval, beta_loc, false);
+        if (bound == -1000) {
+            eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), -1000, 1000, false, args_->stats);
+        }
+        else {
+            eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), bound, bound+1, false, args_->stats); // minimize search window
+            exact = eval > bound;
+            if (eval > bound && eval < 1000) { // if we missed the window, the move is among the best ones, rerun for exact score
+                eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), eval, 1000, false, args_->stats);
             }
+        }
     }
-    else { 
-            eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), beta_loc-1, beta_loc, false); // minimize search window
-            if (eval < beta_loc && eval > alpha_loc) { // if we missed the window and there might still be better move, rerun
-                eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), alpha_loc, eval, false);
+    else {
+        if (bound == 1000) {
+            eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), -1000, 1000, false, args_->stats);
+        }
+        else {
+            eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), bound-1, bound, false, args_->stats); // minimize search window
+            exact = eval < bound;
+            if (eval < bound && eval > -1000) { // if we missed the window, the move is among the best ones, rerun for exact score
+                eval = args_->obj->negascout(next, args_->obj->settings.search_depth-1, !(args_->cur_color), -1000, eval, false, args_->stats);
             }
+        }
     }
 
-    // update alpha beta values
-    args_->obj->m.lock();
-    if (args_->cur_color) *(args_->alpha) = std::max(eval, alpha_loc);
-    else *(args_->beta) = std::min(eval, beta_loc);
-    args_->obj->m.unlock();
+    // update best scores
+    if (exact) {
+        args_->obj->m.lock();
+        args_->obj->add_score(args_->cur_color, eval);
+        args_->obj->m.unlock();
+    }
 
     // save search result
     args_->ret = eval;
+    args_->exact = exact;
 }
 
-uint64_t NegascoutParallel::search(Board state, bool color) {
+template <class BoardT, template <class> class EvalT>
+uint64_t NegascoutParallel<BoardT, EvalT>::search(Board board, bool color) {
+    // engine works with the board backend it was instantiated for, positional score is kept incrementally
+    State state(board);
+
     // transposition table must be empty before calculation of best move, otherwise results would be affected
     transposition_table.clear();
+    auto start = std::chrono::steady_clock::now();
 
-    // prepare vectors for holding results from the threads
+    // prepare vector for holding results from the threads, moves are saved in the search args
     uint64_t possible_moves = state.find_moves(color);
     uint64_t possible_moves_count = std::popcount(possible_moves);
     std::vector<SearchArg> evals(possible_moves_count);
-    std::vector<uint64_t> moves(possible_moves_count);
 
-    // initialize alpha beta values
-    int alpha = -1000;
-    int beta = 1000;
+    // no move is scored yet
+    best_count = 0;
     bool first = true;
 
     int id = 0;
     
-    for (uint64_t move : move_order) {
-        if (possible_moves & move) {
-            // save info about the move
-            SearchArg arg = {state, move, color, &alpha, &beta, 0, this};
-            moves[id] = move;
-            evals[id] = arg;
-            // first move does not run in parallel in order to not completely kill pruning performance
-            if (first) {
-                Board next = state;
-                next.play_move(color, move);
-                int res = negascout(next, settings.search_depth-1, !color, alpha, beta, false);
-                if (color) alpha = res;
-                else beta = res;
-                evals[id].ret = res;
-                first = false;
-            }
-            // other moves are search in parallel with the help of thread manager
-            else {
-                manager.add_task(search_move, static_cast<void*>(&(evals[id])));
-            }
-            id++;
+    // line predicted by the last search is searched first
+    uint64_t first_move = seed_pv(state, color);
+    uint64_t moves[MAX_MOVES];
+    int move_count = order_moves<BoardT>(state, color, possible_moves, settings.search_depth, settings.fastest_first_depth, move_order, first_move, moves);
+    for (int i = 0; i < move_count; ++i) {
+        uint64_t move = moves[i];
+        // save info about the move
+        SearchArg arg = {state, move, color, 0, true, this, SearchStats()};
+        evals[id] = arg;
+        // first move does not run in parallel in order to not completely kill pruning performance
+        if (first) {
+            State next = state;
+            next.play_move(color, move);
+            int res = negascout(next, settings.search_depth-1, !color, -1000, 1000, false, evals[id].stats);
+            add_score(color, res);
+            evals[id].ret = res;
+            first = false;
+        }
+        // other moves are search in parallel with the help of thread manager
+        else {
+            manager.add_task(search_move, static_cast<void*>(&(evals[id])));
         }
+        id++;
     }
 
     // wait until all moves are searched
     manager.join();
 
-    int best_eval;
-    if (color) best_eval = -1000;
-    else best_eval = 1000;
+    // sort the moves from the best one by their score or bound, an exact score goes
+    // before an equal bound, moves with the same score keep the search order,
+    // moves searched with the whole window before there were enough scores
+    // may be worse than a bound, so exact scores are not simply put first
+    last_scores.color = color;
+    last_scores.count = 0;
+    last_stats = SearchStats();
+    for (size_t i = 0; i < evals.size(); ++i) {
+        RootScores::MoveScore score = {evals[i].move, evals[i].ret, evals[i].exact};
+        int j = last_scores.count++;
+        while (j > 0) {
+            const RootScores::MoveScore &prev = last_scores.moves[j - 1];
+            bool better = color ? score.score > prev.score : score.score < prev.score;
+            bool tie_won = score.score == prev.score && score.exact && !prev.exact;
+            if (!better && !tie_won) break;
+            last_scores.moves[j] = prev;
+            --j;
+        }
+        last_scores.moves[j] = score;
+        // gather counters of every task, there are no more writers at this point
+        last_stats += evals[i].stats;
+    }
 
     uint64_t best_move = 0;
-    for (size_t i = 0; i < moves.size(); ++i) {
-        int eval = evals[i].ret;
-        uint64_t move = moves[i];
-        if ((color && eval > best_eval) || (!color && eval < best_eval)) {
-            best_eval = eval;
-            best_move = move;
-        }
+    int best_eval = color ? -1000 : 1000;
+    if (last_scores.count > 0) {
+        best_move = last_scores.moves[0].move;
+        best_eval = last_scores.moves[0].score;
     }
+    collect_pv(state, color, best_move);
+    pv_board = board;
+    pv_color = color;
+    if (!settings.quiet) last_pv.print(settings.search_depth, best_eval);
+    if (!settings.quiet && settings.multipv > 1) last_scores.print();
 
-    std::cout << best_eval << '\n';
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (!settings.quiet) last_stats.print(elapsed.count(), best_eval);
+    total_stats += last_stats;
     return best_move;
 }
 
-int NegascoutParallel::negascout(Board state, int depth, bool cur_color, int alpha, int beta, bool end_board) {
+template <class BoardT, template <class> class EvalT>
+const SearchStats &NegascoutParallel<BoardT, EvalT>::get_last_stats() const {
+    return last_stats;
+}
+
+template <class BoardT, template <class> class EvalT>
+const PrincipalVariation &NegascoutParallel<BoardT, EvalT>::get_last_pv() const {
+    return last_pv;
+}
+
+template <class BoardT, template <class> class EvalT>
+const RootScores &NegascoutParallel<BoardT, EvalT>::get_last_scores() const {
+    return last_scores;
+}
+
+template <class BoardT, template <class> class EvalT>
+void NegascoutParallel<BoardT, EvalT>::collect_pv(State state, bool color, uint64_t move) {
+    // search of the last plies is not counted in the statistics
+    SearchStats stats;
+    int depth = settings.search_depth;
+    last_pv.length = 0;
+    while (move != 0 && last_pv.length < PrincipalVariation::MAX_LENGTH) {
+        last_pv.moves[last_pv.length++] = move;
+        state.play_move(color, move);
+        color = !color;
+        if (--depth == 0) break;
+
+        uint64_t possible_moves = state.find_moves(color);
+        if (possible_moves == 0) {
+            // pass does not use up depth, the same way as in the search
+            possible_moves = state.find_moves(!color);
+            if (possible_moves == 0 || last_pv.length == PrincipalVariation::MAX_LENGTH) break;
+            last_pv.moves[last_pv.length++] = 0;
+            color = !color;
+        }
+
+        if (depth > 2) {
+            if (!settings.transposition_enable) break;
+            int symmetry;
+            uint64_t hash_move;
+            transposition_table.get(tt_key(state, settings.canonical_tt, symmetry), -1000, 1000, 0, hash_move);
+            // illegal move would be a hash collision
+            move = Board::untransform(hash_move, symmetry) & possible_moves;
+        }
+        else {
+            move = pv_move(state, color, depth, possible_moves, move_order, [&](State &child, int child_depth) {
+                return negascout(child, child_depth, !color, -1000, 1000, false, stats);
+            });
+        }
+    }
+}
+
+template <class BoardT, template <class> class EvalT>
+uint64_t NegascoutParallel<BoardT, EvalT>::seed_pv(const State &state, bool color) {
+    return seed_line(state, color, pv_board, pv_color, last_pv, [&](const Board &board, uint64_t move) {
+        if (!settings.transposition_enable) return;
+        int symmetry;
+        uint64_t hash = tt_key(board, settings.canonical_tt, symmetry);
+        transposition_table.insert_move(hash, Board::transform(move, symmetry));
+    });
+}
+
+template <class BoardT, template <class> class EvalT>
+template <int depth, bool cur_color>
+int NegascoutParallel<BoardT, EvalT>::frontier(State &state, int alpha, int beta, bool end_board, SearchStats &stats) {
+    stats.state_count++;
+
+    if constexpr (depth == 0) {
+        stats.heuristic_count++;
+        if (!eval_cache.enabled()) return state.rate_board();
+        return eval_cache.rate_board(state, stats);
+    }
+    else {
+        // if there are no possible moves
+        uint64_t possible_moves = state.find_moves(cur_color);
+        if (possible_moves == 0) {
+            if (end_board) {
+                int count_white = state.count_white();
+                int count_black = state.count_black();
+                if (count_white > count_black) {return 999;}
+                else if (count_white < count_black) {return -999;}
+                else {return 0;}
+            }
+            return frontier<depth, !cur_color>(state, alpha, beta, true, stats);
+        }
+
+        int best_eval = cur_color ? -1000 : 1000;
+        for (uint64_t move : move_order) {
+            if (possible_moves & move) {
+                uint64_t flips = state.flips(cur_color, move);
+                state.apply_move(cur_color, move, flips);
+                int eval = frontier<depth-1, !cur_color>(state, alpha, beta, false, stats);
+                state.undo_move(cur_color, move, flips);
+
+                if constexpr (cur_color) {
+                    best_eval = std::max(eval, best_eval);
+                    alpha = std::max(eval, alpha);
+                }
+                else {
+                    best_eval = std::min(eval, best_eval);
+                    beta = std::min(eval, beta);
+                }
+                if (beta <= alpha) {
+                    stats.cutoff_count++;
+                    break;
+                }
+            }
+        }
+        return best_eval;
+    }
+}
+
+template <class BoardT, template <class> class EvalT>
+int NegascoutParallel<BoardT, EvalT>::negascout(State &state, int depth, bool cur_color, int alpha, int beta, bool end_board, SearchStats &stats) {
+    // last plies are searched by the specialized routines, on the scalar backend as well
+    if (depth <= 2) {
+        if (cur_color) {
+            if (depth == 2) return frontier<2, true>(state, alpha, beta, end_board, stats);
+            if (depth == 1) return frontier<1, true>(state, alpha, beta, end_board, stats);
+            return frontier<0, true>(state, alpha, beta, end_board, stats);
+        }
+        if (depth == 2) return frontier<2, false>(state, alpha, beta, end_board, stats);
+        if (depth == 1) return frontier<1, false>(state, alpha, beta, end_board, stats);
+        return frontier<0, false>(state, alpha, beta, end_board, stats);
+    }
+
     int init_alpha = alpha;
     int init_beta = beta;
     uint64_t hash = 0;
-    
-    // reach max depth
-    if (depth == 0) {
-        return state.rate_board();
-    }
+    int symmetry = 0;
+    uint64_t hash_move = 0;
+    stats.state_count++;
     
     // check if state was already calculated
     // overhead of using transposition table becomes
-    // too large at lower levels, it is then faster
-    // to just calculate the score again
-    if (settings.transposition_enable && depth > 2) {
-        hash = state.hash();
-        int score = transposition_table.get(hash, alpha, beta);
+    // too large at lower levels, so it is used only
+    // above the specialized routines
+    if (settings.transposition_enable) {
+        hash = tt_key(state, settings.canonical_tt, symmetry);
+        int score = transposition_table.get(hash, alpha, beta, depth, hash_move);
+        hash_move = Board::untransform(hash_move, symmetry);
+        stats.tt_probe_count++;
         if (score != TranspositionTableParallel::NOT_FOUND) {
+            stats.tt_hit_count++;
             return score;
         }
     }
 
+    int bound;
+    if (stability_cutoff(state, depth, alpha, beta, bound)) {
+        stats.stability_cutoff_count++;
+        return bound;
+    }
+
     // if there are no possible moves
     uint64_t possible_moves = state.find_moves(cur_color);
     int eval;
@@ -347,71 +947,132 @@ int NegascoutParallel::negascout(Board state, int depth, bool cur_color, int alp
             else {eval = 0;}
         }
         else {
-            eval = negascout(state, depth, !cur_color, alpha, beta, true);
+            eval = negascout(state, depth, !cur_color, alpha, beta, true, stats);
         }
         return eval;
     }
 
+    // internal iterative deepening, without a hash move the node is first searched
+    // to a reduced depth, its best move is then taken from the transposition table,
+    // the reduced search has to stay above the specialized routines, those store no moves
+    uint64_t iid_move = 0;
+    if (hash_move == 0 && settings.transposition_enable && settings.iid_depth != 0 && depth >= settings.iid_depth
+        && depth - settings.iid_reduction > 2) {
+        stats.iid_count++;
+        negascout(state, depth - settings.iid_reduction, cur_color, alpha, beta, end_board, stats);
+        transposition_table.get(hash, alpha, beta, depth, hash_move);
+        hash_move = Board::untransform(hash_move, symmetry);
+        iid_move = hash_move;
+    }
+
     int best_eval;
+    uint64_t best_move = 0;
     bool first = true;
-    Board next;
     if (cur_color == true) {
         best_eval = -1000;
-        for (uint64_t move : move_order) {
-            if (possible_moves & move) {
-                next = state;
-                next.play_move(cur_color, move);
-                
-                if (first) { // run first move with whole window
-                    eval = negascout(next, depth-1, !cur_color, alpha, beta, false);
-                    first = false;
-                }
-                else {
-                    eval = negascout(next, depth-1, !cur_color, alpha, alpha+1, false); // minimize search window
-                    if (eval > alpha && eval < beta) { // if we missed the window and there might still be better move, rerun
-                        eval = negascout(next, depth-1, !cur_color, eval, beta, false);
+        uint64_t moves[MAX_MOVES];
+        int move_count = order_moves<BoardT>(state, cur_color, possible_moves, depth, settings.fastest_first_depth, move_order, hash_move, moves);
+        for (int i = 0; i < move_count; ++i) {
+            uint64_t move = moves[i];
+            uint64_t flips = state.flips(cur_color, move);
+            state.apply_move(cur_color, move, flips);
+            
+            if (first) { // run first move with whole window
+                eval = negascout(state, depth-1, !cur_color, alpha, beta, false, stats);
+                first = false;
+            }
+            else {
+                // late moves are searched to reduced depth, full depth is needed only if they fail high
+                int reduction = move & CORNERS ? 0 : reductions.get(depth, i);
+                eval = negascout(state, depth-1-reduction, !cur_color, alpha, alpha+1, false, stats); // minimize search window
+                if (reduction != 0) {
+                    stats.lmr_count++;
+                    if (eval > alpha) {
+                        stats.lmr_research_count++;
+                        eval = negascout(state, depth-1, !cur_color, alpha, alpha+1, false, stats);
                     }
                 }
-
-                best_eval = std::max(eval, best_eval);
-                alpha = std::max(eval, alpha);
-                if (beta <= alpha) {
-                    break;
+                if (eval > alpha && eval < beta) { // if we missed the window and there might still be better move, rerun
+                    eval = negascout(state, depth-1, !cur_color, eval, beta, false, stats);
                 }
             }
+            state.undo_move(cur_color, move, flips);
+
+            if (eval > best_eval) {
+                best_eval = eval;
+                best_move = move;
+            }
+            alpha = std::max(eval, alpha);
+            if (beta <= alpha) {
+                stats.cutoff_count++;
+                break;
+            }
         }
     }
     else {
         best_eval = 1000;
-        for (uint64_t move : move_order) {
-            if (possible_moves & move) {
-                next = state;
-                next.play_move(cur_color, move);
+        uint64_t moves[MAX_MOVES];
+        int move_count = order_moves<BoardT>(state, cur_color, possible_moves, depth, settings.fastest_first_depth, move_order, hash_move, moves);
+        for (int i = 0; i < move_count; ++i) {
+            uint64_t move = moves[i];
+            uint64_t flips = state.flips(cur_color, move);
+            state.apply_move(cur_color, move, flips);
 
-                if (first) { // run first move with whole window
-                    eval = negascout(next, depth-1, !cur_color, alpha, beta, false);
-                    first = false;
-                }
-                else {
-                    eval = negascout(next, depth-1, !cur_color, beta-1, beta, false); // minimize search window
-                    if (eval < beta && eval > alpha) { // if we missed the window and there might still be better move, rerun
-                        eval = negascout(next, depth-1, !cur_color, alpha, eval, false);
+            if (first) { // run first move with whole window
+                eval = negascout(state, depth-1, !cur_color, alpha, beta, false, stats);
+                first = false;
+            }
+            else {
+                int reduction = move & CORNERS ? 0 : reductions.get(depth, i);
+                eval = negascout(state, depth-1-reduction, !cur_color, beta-1, beta, false, stats); // minimize search window
+                if (reduction != 0) {
+                    stats.lmr_count++;
+                    if (eval < beta) {
+                        stats.lmr_research_count++;
+                        eval = negascout(state, depth-1, !cur_color, beta-1, beta, false, stats);
                     }
                 }
-                
-                best_eval = std::min(eval, best_eval);
-                beta = std::min(eval, beta);
-                if (beta <= alpha) {
-                    break;
+                if (eval < beta && eval > alpha) { // if we missed the window and there might still be better move, rerun
+                    eval = negascout(state, depth-1, !cur_color, alpha, eval, false, stats);
                 }
             }
+            state.undo_move(cur_color, move, flips);
+
+            if (eval < best_eval) {
+                best_eval = eval;
+                best_move = move;
+            }
+            beta = std::min(eval, beta);
+            if (beta <= alpha) {
+                stats.cutoff_count++;
+                break;
+            }
         }
     }
     
-    // save the score for future
-    if (settings.transposition_enable && depth > 2) {
-        transposition_table.insert(hash, best_eval, init_alpha, init_beta);
+    if (iid_move != 0) {
+        stats.iid_move_count++;
+        stats.iid_best_count += best_move == iid_move;
+    }
+
+    // save the score for future, best move is kept only if it improved the bound,
+    // scores of the moves are not comparable otherwise and the old hash move is kept
+    if (settings.transposition_enable) {
+        bool improved = cur_color ? best_eval > init_alpha : best_eval < init_beta;
+        uint64_t stored_move = improved ? best_move : hash_move;
+        transposition_table.insert(hash, best_eval, init_alpha, init_beta, depth, Board::transform(stored_move, symmetry));
     }
 
     return best_eval;
 }
+
+// engines are compiled once for every board backend, see CMakeLists.txt,
+// and for every evaluator of the backend
+template class Negascout<BOARD_BACKEND, TableEval>;
+template class Negascout<BOARD_BACKEND, IncrementalBoard>;
+template class Negascout<BOARD_BACKEND, BitplaneBoard>;
+template class Negascout<BOARD_BACKEND, PatternBoard>;
+template class NegascoutParallel<BOARD_BACKEND, TableEval>;
+template class NegascoutParallel<BOARD_BACKEND, IncrementalBoard>;
+template class NegascoutParallel<BOARD_BACKEND, BitplaneBoard>;
+template class NegascoutParallel<BOARD_BACKEND, PatternBoard>;
@@ -0,0 +1,34 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "engine/principal_variation.h"
+#include <bit>
+#include <iostream>
+
+void PrincipalVariation::print(int depth, int eval) const {
+    std::cout << "Depth " << depth << "  eval " << eval << "  pv";
+    for (int i = 0; i < length; ++i) {
+        if (moves[i] == 0) {
+            std::cout << " pass";
+            continue;
+        }
+        // bit 63 is the upper left square
+        int square = 64 - std::bit_width(moves[i]);
+        std::cout << ' ' << square % 8 << ',' << square / 8;
+    }
+    std::cout << '\n';
+}
@@ -0,0 +1,43 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+// Compiller suggestion for LTO inlining
+#if defined(__GNUC__) || defined(__clang__)
+    #define ALWAYS_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+    #define ALWAYS_INLINE __forceinline
+#else
+    #define ALWAYS_INLINE
+#endif
+
+#include "engine/reductions.h"
+#include <algorithm>
+
+Reductions::Reductions(int min_depth, int full_moves, int max_reduction) : table() {
+    if (min_depth == 0) return;
+    for (int depth = std::max(min_depth, 3); depth < MAX_DEPTH; ++depth) {
+        for (int index = full_moves; index < MAX_MOVES; ++index) {
+            // at least one ply is left for the reduced search
+            int reduction = std::min({1 + (index - full_moves) / full_moves, max_reduction, depth - 2});
+            table[depth][index] = static_cast<uint8_t>(reduction);
+        }
+    }
+}
+
+ALWAYS_INLINE int Reductions::get(int depth, int index) const {
+    return table[depth][index];
+}
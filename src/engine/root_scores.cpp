@@ -0,0 +1,33 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "engine/root_scores.h"
+#include <bit>
+#include <iostream>
+
+void RootScores::print() const {
+    for (int i = 0; i < count; ++i) {
+        // bit 63 is the upper left square
+        int square = 64 - std::bit_width(moves[i].move);
+        std::cout << "Move " << square % 8 << ',' << square / 8 << "  ";
+        if (!moves[i].exact) {
+            // moves outside of the best ones are worse than the last exact score
+            std::cout << (color ? "<= " : ">= ");
+        }
+        std::cout << moves[i].score << '\n';
+    }
+}
@@ -0,0 +1,70 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "engine/search_stats.h"
+#include <iostream>
+
+SearchStats &SearchStats::operator+=(const SearchStats &other) {
+    state_count += other.state_count;
+    heuristic_count += other.heuristic_count;
+    tt_probe_count += other.tt_probe_count;
+    tt_hit_count += other.tt_hit_count;
+    cutoff_count += other.cutoff_count;
+    stability_cutoff_count += other.stability_cutoff_count;
+    iid_count += other.iid_count;
+    iid_move_count += other.iid_move_count;
+    iid_best_count += other.iid_best_count;
+    lmr_count += other.lmr_count;
+    lmr_research_count += other.lmr_research_count;
+    eval_cache_probe_count += other.eval_cache_probe_count;
+    eval_cache_hit_count += other.eval_cache_hit_count;
+    return *this;
+}
+
+void SearchStats::print(double seconds, int eval) const {
+    std::cout << "Went through " << state_count     << " states.\n";
+    std::cout << "Analyzed     " << heuristic_count << " states.\n";
+    std::cout << "TT hits      " << tt_hit_count    << " states";
+    if (tt_probe_count > 0) {
+        std::cout << " (" << 100.0 * tt_hit_count / tt_probe_count << " % of " << tt_probe_count << " probes)";
+    }
+    std::cout << ".\n";
+    std::cout << "Cutoffs      " << cutoff_count    << " times.\n";
+    std::cout << "Stable cuts  " << stability_cutoff_count << " states.\n";
+    if (iid_count > 0) {
+        std::cout << "IID          " << iid_count << " searches, " << iid_move_count << " found a move";
+        if (iid_move_count > 0) {
+            std::cout << " (" << 100.0 * iid_best_count / iid_move_count << " % stayed the best)";
+        }
+        std::cout << ".\n";
+    }
+    if (lmr_count > 0) {
+        std::cout << "LMR          " << lmr_count << " reduced searches, " << lmr_research_count << " re-searched ("
+                  << 100.0 * lmr_research_count / lmr_count << " %).\n";
+    }
+    // hit rate decides whether the cache beats recomputing the leaves on the backend
+    if (eval_cache_probe_count > 0) {
+        std::cout << "Cache hits   " << eval_cache_hit_count << " leaves ("
+                  << 100.0 * eval_cache_hit_count / eval_cache_probe_count << " %).\n";
+    }
+    std::cout << "Search took  " << seconds * 1000  << " ms.\n";
+    if (seconds > 0) {
+        std::cout << "Speed        " << static_cast<unsigned long long int>(state_count / seconds) << " states/s.\n";
+        std::cout << "Leaf speed   " << static_cast<unsigned long long int>(heuristic_count / seconds) << " leaves/s.\n";
+    }
+    std::cout << eval << '\n';
+}
@@ -26,13 +26,19 @@
 
 #include "engine/transposition_table.h"
 
+TranspositionTable::TranspositionTable() {}
+
+TranspositionTable::~TranspositionTable() {}
+
 void TranspositionTable::clear() {
     map.clear();
 }
 
-ALWAYS_INLINE void TranspositionTable::insert(uint64_t hash, int score, int alpha, int beta) {
+ALWAYS_INLINE void TranspositionTable::insert(uint64_t hash, int score, int alpha, int beta, int depth, uint64_t move) {
     Entry e;
     e.score = score;
+    e.depth = depth;
+    e.move = move;
     if (score <= alpha) {
         e.type = 2;
     }
@@ -45,9 +51,20 @@ ALWAYS_INLINE void TranspositionTable::insert(uint64_t hash, int score, int alph
     map[hash] = e;
 }
 
-ALWAYS_INLINE int TranspositionTable::get(uint64_t hash, int alpha, int beta) {
+ALWAYS_INLINE void TranspositionTable::insert_move(uint64_t hash, uint64_t move) {
+    // negative depth is never enough for the score to be used
+    map.try_emplace(hash, Entry{0, 0, -1, move});
+}
+
+ALWAYS_INLINE int TranspositionTable::get(uint64_t hash, int alpha, int beta, int depth, uint64_t &move) {
+    move = 0;
     if (map.find(hash) != map.end()) {
         Entry e = map[hash];
+        move = e.move;
+        // score of a shallower search cannot replace the deeper one
+        if (e.depth < depth) {
+            return NOT_FOUND;
+        }
         if (e.type == 0) {
             return e.score;
         }
@@ -63,16 +80,20 @@ ALWAYS_INLINE int TranspositionTable::get(uint64_t hash, int alpha, int beta) {
 
 TranspositionTableParallel::TranspositionTableParallel() : maps(map_count), mutexes(map_count) {}
 
+TranspositionTableParallel::~TranspositionTableParallel() {}
+
 void TranspositionTableParallel::clear() {
     for (auto &m : maps) {
         m.clear();
     }
 }
 
-ALWAYS_INLINE void TranspositionTableParallel::insert(uint64_t hash, int score, int alpha, int beta) {
+ALWAYS_INLINE void TranspositionTableParallel::insert(uint64_t hash, int score, int alpha, int beta, int depth, uint64_t move) {
     uint64_t id = hash % map_count;
     Entry e;
     e.score = score;
+    e.depth = depth;
+    e.move = move;
     if (score <= alpha) {
         e.type = 2;
     }
@@ -87,12 +108,26 @@ ALWAYS_INLINE void TranspositionTableParallel::insert(uint64_t hash, int score,
     mutexes[id].unlock();
 }
 
-ALWAYS_INLINE int TranspositionTableParallel::get(uint64_t hash, int alpha, int beta) {
+ALWAYS_INLINE void TranspositionTableParallel::insert_move(uint64_t hash, uint64_t move) {
     uint64_t id = hash % map_count;
     mutexes[id].lock();
+    // negative depth is never enough for the score to be used
+    maps[id].try_emplace(hash, Entry{0, 0, -1, move});
+    mutexes[id].unlock();
+}
+
+ALWAYS_INLINE int TranspositionTableParallel::get(uint64_t hash, int alpha, int beta, int depth, uint64_t &move) {
+    uint64_t id = hash % map_count;
+    move = 0;
+    mutexes[id].lock();
     if (maps[id].find(hash) != maps[id].end()) {
         Entry e = maps[id][hash];
         mutexes[id].unlock();
+        move = e.move;
+        // score of a shallower search cannot replace the deeper one
+        if (e.depth < depth) {
+            return NOT_FOUND;
+        }
         if (e.type == 0) {
             return e.score;
         }
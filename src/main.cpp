@@ -19,19 +19,92 @@
 #include "ui/terminal.h"
 #include "engine/negascout.h"
 #include "engine/alphabeta.h"
+#include "board/backend.h"
+#include "board/board_avx2.h"
+#include "board/board_avx512.h"
+#include "board/board_bmi2.h"
+#include "board/board_sse.h"
+#include "board/bitplane_board.h"
+#include "board/incremental_board.h"
+#include "board/pattern_board.h"
+#include "board/pattern_eval.h"
 #include "utils/parser.h"
+#include <iostream>
 #include <signal.h>
+#include <unistd.h>
 
 // needs to be file-global to be accessible in sig function
 static UI *ui = nullptr;
 static Engine *engine = nullptr;
+static Engine *reference = nullptr;
 
 // restores terminal state even after ctrl-c or other failure
 void handle_sig(int sig) {
     // safely dealocate resources
     if (ui) delete ui;
-    if (engine) delete engine;
-    exit(sig);
+    std::cout.flush();
+    // engine may still be pondering on another thread, it is only stopped,
+    // _exit skips static destructors that thread may still use
+    if (engine) engine->stop_ponder();
+    _exit(sig);
+}
+
+// engines are instantiated for every board backend and evaluator, both are
+// selected only once here, so the search runs without any dispatch
+template <class BoardT, template <class> class EvalT>
+static Engine *create_search(Engine::Alg alg, Engine::Settings settings) {
+    if (alg == Engine::Alg::ALPHABETA) {
+        return new Alphabeta<BoardT, EvalT>(settings);
+    }
+    else if (alg == Engine::Alg::NEGASCOUT && (settings.thread_count > 1 || settings.multipv > 1)) {
+        return new NegascoutParallel<BoardT, EvalT>(settings);
+    }
+    else {
+        return new Negascout<BoardT, EvalT>(settings);
+    }
+}
+
+template <class BoardT>
+static Engine *create_engine(Engine::Alg alg, Engine::Settings settings, Engine::Eval eval) {
+    switch (eval) {
+        case Engine::Eval::TABLE:
+            return create_search<BoardT, TableEval>(alg, settings);
+        case Engine::Eval::INCREMENTAL:
+            return create_search<BoardT, IncrementalBoard>(alg, settings);
+        case Engine::Eval::BITPLANE:
+            return create_search<BoardT, BitplaneBoard>(alg, settings);
+        case Engine::Eval::PATTERN:
+            return create_search<BoardT, PatternBoard>(alg, settings);
+        default:
+            // backend decides whether keeping the score across moves pays off
+            if constexpr (BoardT::INCREMENTAL_EVAL) return create_search<BoardT, IncrementalBoard>(alg, settings);
+            else return create_search<BoardT, TableEval>(alg, settings);
+    }
+}
+
+// selects the engine instance of the board backend
+static Engine *create_engine(Backend::Type backend, Engine::Alg alg, Engine::Settings settings, Engine::Eval eval) {
+#ifdef REVERSAN_AVX512
+    if (backend == Backend::Type::AVX512) {
+        return create_engine<BoardAVX512>(alg, settings, eval);
+    }
+#endif
+#ifdef REVERSAN_BMI2
+    if (backend == Backend::Type::BMI2) {
+        return create_engine<BoardBMI2>(alg, settings, eval);
+    }
+#endif
+#ifdef REVERSAN_AVX2
+    if (backend == Backend::Type::AVX2) {
+        return create_engine<BoardAVX2>(alg, settings, eval);
+    }
+#endif
+#ifdef REVERSAN_SSE
+    if (backend == Backend::Type::SSE) {
+        return create_engine<BoardSSE>(alg, settings, eval);
+    }
+#endif
+    return create_engine<Board>(alg, settings, eval);
 }
 
 int main(int argc, char **argv) {
@@ -42,26 +115,41 @@ int main(int argc, char **argv) {
     Parser parser;
     if (!parser.parse(argc, argv)) return 1;
 
-    // initialize engine
-    if (parser.get_alg() == Engine::Alg::ALPHABETA) {
-        engine = new Alphabeta(parser.get_settings());
+    // select board backend
+    Backend::Type backend = parser.get_backend();
+    if (backend == Backend::Type::AUTO) {
+        backend = Backend::detect();
     }
-    else if (parser.get_alg() == Engine::Alg::NEGASCOUT && parser.get_settings().thread_count > 1) {
-        engine = new NegascoutParallel(parser.get_settings());
+    else if (!Backend::available(backend)) {
+        std::cout << "Backend " << Backend::name(backend) << " is not supported by this build or CPU.\n";
+        return 1;
     }
-    else {
-        engine = new Negascout(parser.get_settings());
+
+    // load pattern weights
+    if (!parser.get_weights().empty() && !PatternEval::load(parser.get_weights().c_str())) {
+        return 1;
+    }
+
+    // initialize engine
+    engine = create_engine(backend, parser.get_alg(), parser.get_settings(), parser.get_eval());
+
+    // suite compares the moves of reduced search with the full-width search
+    Engine::Settings reference_settings = parser.get_settings();
+    if (parser.get_mode() == App::Mode::SUITE && reference_settings.lmr_depth != 0) {
+        reference_settings.lmr_depth = 0;
+        reference = create_engine(backend, parser.get_alg(), reference_settings, parser.get_eval());
     }
 
     // initialize terminal
     ui = new Terminal(parser.get_style());
 
     // initialize app
-    App app(parser.get_mode(), ui, engine);
+    App app(parser.get_mode(), ui, engine, reference, parser.get_self_play());
     app.run();
 
     // dealocate resources and exit
     delete ui;
     delete engine;
+    delete reference;
     return 0;
 }
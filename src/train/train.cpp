@@ -0,0 +1,233 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "board/pattern_eval.h"
+#include "utils/position_file.h"
+#include "utils/thread_manager.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fits pattern weights to the final disc differential of recorded self-play positions.
+//
+// Every phase is an independent linear model, score of a position is the sum of
+// the weights of its 46 pattern instances plus the feature weights times the
+// differences of stable discs, frontier discs and potential moves. Weights are
+// fitted by batch gradient descent on the squared error, step of every weight
+// is divided by the sum of squared feature values (number of positions using
+// it for patterns), so rare configurations do not overshoot.
+
+// disc differential is scaled to the range of the square table evaluation
+static constexpr float DISC_SCALE = 8.0f;
+
+// learning rate shared by all features of a position
+static constexpr float LEARNING_RATE = 1.0f / (PatternEval::INSTANCE_COUNT + PatternEval::FEATURE_COUNT);
+
+// added to the occurrence count, pulls rarely seen weights towards zero
+static constexpr float SMOOTHING = 8.0f;
+
+/// @brief Training data of one game phase.
+struct PhaseData {
+    /// @brief INSTANCE_COUNT weight indices of every position.
+    std::vector<int> indices;
+    /// @brief FEATURE_COUNT whole-board features of every position (see PatternEval::features).
+    std::vector<float> features;
+    /// @brief Scaled disc differential of every position.
+    std::vector<float> targets;
+    /// @brief Sum of squared feature values of every weight.
+    std::vector<float> counts;
+    /// @brief Fitted weights.
+    std::vector<float> weights;
+};
+
+/// @brief Work of one thread in one iteration.
+struct GradientTask {
+    const PhaseData *data;
+    size_t begin;
+    size_t end;
+    /// @brief Sum of errors times feature values of every weight.
+    std::vector<float> gradient;
+    /// @brief Sum of squared errors.
+    double loss;
+};
+
+static void compute_gradient(void *args) {
+    GradientTask *task = static_cast<GradientTask*>(args);
+    const PhaseData &data = *task->data;
+    std::fill(task->gradient.begin(), task->gradient.end(), 0.0f);
+    task->loss = 0;
+    for (size_t p = task->begin; p < task->end; ++p) {
+        const int *indices = &data.indices[p * PatternEval::INSTANCE_COUNT];
+        const float *features = &data.features[p * PatternEval::FEATURE_COUNT];
+        float score = 0;
+        for (int i = 0; i < PatternEval::FEATURE_COUNT; ++i) {
+            score += data.weights[PatternEval::STABILITY_OFFSET + i] * features[i];
+        }
+        for (int i = 0; i < PatternEval::INSTANCE_COUNT; ++i) {
+            score += data.weights[indices[i]];
+        }
+        float error = data.targets[p] - score;
+        for (int i = 0; i < PatternEval::INSTANCE_COUNT; ++i) {
+            task->gradient[indices[i]] += error;
+        }
+        for (int i = 0; i < PatternEval::FEATURE_COUNT; ++i) {
+            task->gradient[PatternEval::STABILITY_OFFSET + i] += error * features[i];
+        }
+        task->loss += error * error;
+    }
+}
+
+static void print_help() {
+    std::cout
+        << "Usage: reversan_train [OPTIONS] <positions file>...\n"
+        << "\n"
+        << "Fits pattern weights to positions recorded by 'reversan --self-play'.\n"
+        << "\n"
+        << "Options:\n"
+        << "--output, -o <file> [weights.bin]      File the weights are written to.\n"
+        << "--iterations, -i <1 - 100000> [200]    Number of gradient descent iterations.\n"
+        << "--threads, -t <1 - 256> [all cores]    Number of threads.\n"
+        << "--help, -h                             Display this help message.\n";
+}
+
+int main(int argc, char **argv) {
+    std::string output = "weights.bin";
+    int iterations = 200;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            print_help();
+            return 0;
+        }
+        else if ((arg == "--output" || arg == "-o") && has_value) {
+            output = argv[++i];
+        }
+        else if ((arg == "--iterations" || arg == "-i") && has_value) {
+            iterations = std::atoi(argv[++i]);
+            if (iterations < 1 || iterations > 100000) {
+                std::cout << "Invalid number of iterations. Use --help or -h for usage information.\n";
+                return 1;
+            }
+        }
+        else if ((arg == "--threads" || arg == "-t") && has_value) {
+            threads = std::atoi(argv[++i]);
+            if (threads < 1 || threads > 256) {
+                std::cout << "Invalid thread count. Use --help or -h for usage information.\n";
+                return 1;
+            }
+        }
+        else if (arg.rfind("-", 0) == 0) {
+            std::cout << "Invalid option. Use --help or -h for usage information.\n";
+            return 1;
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        std::cout << "No positions file given. Use --help or -h for usage information.\n";
+        return 1;
+    }
+
+    std::vector<PositionFile::Record> records;
+    for (const std::string &input : inputs) {
+        if (!PositionFile::read(input.c_str(), records)) return 1;
+    }
+    std::cout << "Loaded " << records.size() << " positions.\n";
+
+    // indices are computed once, iterations then only walk the arrays
+    std::vector<PhaseData> phases(PatternEval::PHASES);
+    for (PhaseData &data : phases) {
+        data.counts.assign(PatternEval::PHASE_SIZE, 0.0f);
+        data.weights.assign(PatternEval::PHASE_SIZE, 0.0f);
+    }
+    for (const PositionFile::Record &record : records) {
+        PhaseData &data = phases[PatternEval::phase(std::popcount(record.white | record.black))];
+        int indices[PatternEval::INSTANCE_COUNT];
+        PatternEval::indices(record.white, record.black, indices);
+        for (int index : indices) {
+            data.indices.push_back(index);
+            data.counts[index] += 1.0f;
+        }
+        int features[PatternEval::FEATURE_COUNT];
+        PatternEval::features(record.white, record.black, features);
+        for (int i = 0; i < PatternEval::FEATURE_COUNT; ++i) {
+            float feature = static_cast<float>(features[i]);
+            data.features.push_back(feature);
+            data.counts[PatternEval::STABILITY_OFFSET + i] += feature * feature;
+        }
+        data.targets.push_back(DISC_SCALE * record.disc_diff);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ThreadManager manager(threads);
+    std::vector<GradientTask> tasks(threads);
+    for (GradientTask &task : tasks) {
+        task.gradient.resize(PatternEval::PHASE_SIZE);
+    }
+    std::vector<int16_t> result(PatternEval::PHASES * PatternEval::PHASE_SIZE);
+
+    for (int phase = 0; phase < PatternEval::PHASES; ++phase) {
+        PhaseData &data = phases[phase];
+        size_t count = data.targets.size();
+        if (count == 0) continue;
+
+        for (int iteration = 0; iteration < iterations; ++iteration) {
+            // positions are split evenly between the threads
+            for (int t = 0; t < threads; ++t) {
+                tasks[t].data = &data;
+                tasks[t].begin = count * t / threads;
+                tasks[t].end = count * (t + 1) / threads;
+                manager.add_task(compute_gradient, &tasks[t]);
+            }
+            manager.join();
+
+            double loss = 0;
+            for (const GradientTask &task : tasks) loss += task.loss;
+            for (int i = 0; i < PatternEval::PHASE_SIZE; ++i) {
+                float gradient = 0;
+                for (const GradientTask &task : tasks) gradient += task.gradient[i];
+                data.weights[i] += LEARNING_RATE * gradient / (data.counts[i] + SMOOTHING);
+            }
+            if (iteration == 0 || (iteration + 1) % 50 == 0) {
+                double error = std::sqrt(loss / count) / DISC_SCALE;
+                std::cout << "phase " << phase << "  iteration " << iteration + 1 << "  rms error " << error << " discs\n";
+            }
+        }
+
+        for (int i = 0; i < PatternEval::PHASE_SIZE; ++i) {
+            float weight = std::round(data.weights[i]);
+            result[phase * PatternEval::PHASE_SIZE + i] = static_cast<int16_t>(std::clamp(weight, -32768.0f, 32767.0f));
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Training took " << elapsed.count() << " s.\n";
+
+    if (!PatternEval::save(output.c_str(), result.data())) return 1;
+    std::cout << "Weights written to " << output << ".\n";
+    return 0;
+}
@@ -22,13 +22,20 @@ Parser::Parser() :
     mode(DefaultSettings::MODE),
     style(DefaultSettings::STYLE),
     alg(DefaultSettings::ALG),
-    settings(DefaultSettings::SETTINGS)
+    eval(DefaultSettings::EVAL),
+    settings(DefaultSettings::SETTINGS),
+    backend(DefaultSettings::BACKEND),
+    self_play(DefaultSettings::SELF_PLAY)
 {}
 
 App::Mode Parser::get_mode() const {return mode;}
 UI::UIStyle Parser::get_style() const {return style;}
 Engine::Alg Parser::get_alg() const {return alg;}
+Engine::Eval Parser::get_eval() const {return eval;}
 Engine::Settings Parser::get_settings() const {return settings;}
+Backend::Type Parser::get_backend() const {return backend;}
+const std::string &Parser::get_weights() const {return weights;}
+App::SelfPlay Parser::get_self_play() const {return self_play;}
 
 void Parser::print_help() const {
     std::cout 
@@ -39,14 +46,36 @@ void Parser::print_help() const {
         << "--play                                    Play against the engine in terminal interface.\n"
         << "--bot-vs-bot                              Start game where the engine plays against itself.\n"
         << "--benchmark                               Run search on pre-defined state.\n"
+        << "--kernel-benchmark                        Measure speed of board functions on random states.\n"
+        << "--verify-eval                             Check incremental evaluation against full recompute.\n"
+        << "--self-play                               Record positions of engine self-play games for training.\n"
+        << "--suite                                   Run search on a fixed set of random positions, report states and time.\n"
         << "\n"
         << "Additional Options:\n"
         << "--depth, -d <1 - 49> [10]                           Set the engine's search depth.\n"
         << "--engine, -e <negascout | alphabeta> [negascout]    Choose the tree search algorithm.\n"
+        << "--eval <auto | table | incremental | bitplane | pattern> [auto]\n"
+        << "                                                    Choose the evaluation, pattern needs --weights.\n"
         << "--threads, -t, <1 - 8> [1]                          EXPERIMENTAL, negascout only.\n"
         << "--disable-tp                                        Disables transposition tables.\n"
+        << "--disable-id                                        Searches only the full depth instead of deepening by two plies, negascout only.\n"
+        << "--disable-ponder                                    Engine does not search while the player is thinking, negascout only.\n"
+        << "--eval-cache, -c <0 - 4096> [0]                     Size of the leaf evaluation cache in MiB, 0 disables it.\n"
+        << "--canonical-tt                                      Shares transposition table entries between symmetric positions.\n"
         << "--order, -o <line_by_line | opt1 | opt2> [opt1]     Sets search order of the engine.\n"
-        << "--style, -s <basic | solarized | dracula> [basic]   Specify UI style.\n";
+        << "--iid <0 - 49> [7]                                  Searches nodes without hash move to reduced depth first from this depth up, negascout only, 0 disables it.\n"
+        << "--iid-reduction <1 - 10> [3]                        Depth reduction of the internal iterative deepening search.\n"
+        << "--lmr <0 - 49> [0]                                  Reduces depth of late non-corner moves from this depth up, negascout only, 0 disables it.\n"
+        << "--lmr-moves <1 - 63> [4]                            Number of moves searched to full depth, reduction grows by one after each such group.\n"
+        << "--lmr-reduction <1 - 10> [1]                        Largest depth reduction of a late move.\n"
+        << "--fastest-first, -f <0 - 49> [4]                    Orders moves by opponent mobility from this remaining depth up, negascout only, 0 disables it.\n"
+        << "--multipv <1 - 64> [1]                              Scores this many best moves exactly, runs the parallel negascout.\n"
+        << "--style, -s <basic | solarized | dracula> [basic]   Specify UI style.\n"
+        << "--backend, -b <auto | nosimd | sse | avx2 | avx512 | bmi2> [auto]\n"
+        << "                                                    Override board backend selected by CPU detection.\n"
+        << "--weights, -w <file>                                Load pattern weights, selects pattern evaluation by default.\n"
+        << "--games, -g <1 - 1000000> [1000]                    Number of self-play games.\n"
+        << "--record, -r <file> [selfplay.bin]                  File the self-play positions are written to.\n";
 }
 
 bool Parser::parse_mode(int argc, char **argv) {
@@ -59,6 +88,10 @@ bool Parser::parse_mode(int argc, char **argv) {
     if (arg == "--play") mode = App::Mode::PLAY;
     else if (arg == "--bot-vs-bot") mode = App::Mode::BOT_VS_BOT;
     else if (arg == "--benchmark") mode = App::Mode::BENCHMARK;
+    else if (arg == "--kernel-benchmark") mode = App::Mode::KERNEL_BENCHMARK;
+    else if (arg == "--verify-eval") mode = App::Mode::VERIFY_EVAL;
+    else if (arg == "--self-play") mode = App::Mode::SELF_PLAY;
+    else if (arg == "--suite") mode = App::Mode::SUITE;
     else return false;
     // return true if mode was parsed
     return true;
@@ -98,6 +131,27 @@ bool Parser::parse_engine(int argc, char **argv, int &i) {
     return true;
 }
 
+bool Parser::parse_eval(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        std::string arg = argv[i];
+        if (arg == "auto") eval = Engine::Eval::AUTO;
+        else if (arg == "table") eval = Engine::Eval::TABLE;
+        else if (arg == "incremental") eval = Engine::Eval::INCREMENTAL;
+        else if (arg == "bitplane") eval = Engine::Eval::BITPLANE;
+        else if (arg == "pattern") eval = Engine::Eval::PATTERN;
+        else {
+            std::cout << "Invalid evaluator. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --eval requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
 bool Parser::parse_style(int argc, char **argv, int &i) {
     if (i + 1 < argc) {
         i++;
@@ -133,6 +187,134 @@ bool Parser::parse_threads(int argc, char **argv, int &i) {
     return true;
 }
 
+bool Parser::parse_eval_cache(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.eval_cache_size = std::atoi(argv[i]);
+        if (settings.eval_cache_size < 0 || settings.eval_cache_size > 4096) {
+            std::cout << "Invalid evaluation cache size. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flags --eval-cache and -c require an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_fastest_first(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.fastest_first_depth = std::atoi(argv[i]);
+        if (settings.fastest_first_depth < 0 || settings.fastest_first_depth > 49) {
+            std::cout << "Invalid fastest-first depth. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flags --fastest-first and -f require an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_iid(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.iid_depth = std::atoi(argv[i]);
+        if (settings.iid_depth < 0 || settings.iid_depth > 49) {
+            std::cout << "Invalid internal iterative deepening depth. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --iid requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_iid_reduction(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.iid_reduction = std::atoi(argv[i]);
+        if (settings.iid_reduction < 1 || settings.iid_reduction > 10) {
+            std::cout << "Invalid internal iterative deepening reduction. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --iid-reduction requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_lmr(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.lmr_depth = std::atoi(argv[i]);
+        if (settings.lmr_depth < 0 || settings.lmr_depth > 49) {
+            std::cout << "Invalid late move reduction depth. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --lmr requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_lmr_moves(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.lmr_moves = std::atoi(argv[i]);
+        if (settings.lmr_moves < 1 || settings.lmr_moves > 63) {
+            std::cout << "Invalid number of full depth moves. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --lmr-moves requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_lmr_reduction(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.lmr_reduction = std::atoi(argv[i]);
+        if (settings.lmr_reduction < 1 || settings.lmr_reduction > 10) {
+            std::cout << "Invalid late move reduction. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --lmr-reduction requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_multipv(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        settings.multipv = std::atoi(argv[i]);
+        if (settings.multipv < 1 || settings.multipv > 64) {
+            std::cout << "Invalid number of scored moves. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flag --multipv requires an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
 bool Parser::parse_order(int argc, char **argv, int &i) {
     if (i + 1 < argc) {
         i++;
@@ -152,6 +334,68 @@ bool Parser::parse_order(int argc, char **argv, int &i) {
     return true;
 }
 
+bool Parser::parse_backend(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        std::string arg = argv[i];
+        if (arg == "auto") backend = Backend::Type::AUTO;
+        else if (arg == "nosimd") backend = Backend::Type::NOSIMD;
+        else if (arg == "avx2") backend = Backend::Type::AVX2;
+        else if (arg == "avx512") backend = Backend::Type::AVX512;
+        else if (arg == "bmi2") backend = Backend::Type::BMI2;
+        else if (arg == "sse") backend = Backend::Type::SSE;
+        else {
+            std::cout << "Invalid backend. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flags --backend and -b require an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_weights(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        weights = argv[i];
+    }
+    else {
+        std::cout << "Flags --weights and -w require an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_games(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        self_play.games = std::atoi(argv[i]);
+        if (self_play.games < 1 || self_play.games > 1000000) {
+            std::cout << "Invalid number of games. Use --help or -h for usage information.\n";
+            return false;
+        }
+    }
+    else {
+        std::cout << "Flags --games and -g require an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
+bool Parser::parse_record(int argc, char **argv, int &i) {
+    if (i + 1 < argc) {
+        i++;
+        self_play.path = argv[i];
+    }
+    else {
+        std::cout << "Flags --record and -r require an additional argument. Use --help or -h for usage information.\n";
+        return false;
+    }
+    return true;
+}
+
 bool Parser::parse(int argc, char **argv) {
     int idx = 1;
     // parse mode
@@ -167,6 +411,9 @@ bool Parser::parse(int argc, char **argv) {
         else if (arg == "--engine" || arg == "-e") {
             if (!parse_engine(argc, argv, i)) return false;
         }
+        else if (arg == "--eval") {
+            if (!parse_eval(argc, argv, i)) return false;
+        }
         else if (arg == "--style" || arg == "-s") {
             if (!parse_style(argc, argv, i)) return false;
         }
@@ -180,14 +427,72 @@ bool Parser::parse(int argc, char **argv) {
         else if (arg == "--disable-tp") {
             settings.transposition_enable = false;
         }
+        else if (arg == "--disable-id") {
+            settings.iterative_deepening = false;
+        }
+        else if (arg == "--disable-ponder") {
+            settings.ponder = false;
+        }
+        else if (arg == "--canonical-tt") {
+            settings.canonical_tt = true;
+        }
+        else if (arg == "--eval-cache" || arg == "-c") {
+            if (!parse_eval_cache(argc, argv, i)) return false;
+        }
+        else if (arg == "--fastest-first" || arg == "-f") {
+            if (!parse_fastest_first(argc, argv, i)) return false;
+        }
+        else if (arg == "--iid") {
+            if (!parse_iid(argc, argv, i)) return false;
+        }
+        else if (arg == "--iid-reduction") {
+            if (!parse_iid_reduction(argc, argv, i)) return false;
+        }
+        else if (arg == "--lmr") {
+            if (!parse_lmr(argc, argv, i)) return false;
+        }
+        else if (arg == "--lmr-moves") {
+            if (!parse_lmr_moves(argc, argv, i)) return false;
+        }
+        else if (arg == "--lmr-reduction") {
+            if (!parse_lmr_reduction(argc, argv, i)) return false;
+        }
+        else if (arg == "--multipv") {
+            if (!parse_multipv(argc, argv, i)) return false;
+        }
         else if (arg == "--order" || arg == "-o") {
             if (!parse_order(argc, argv, i)) return false;
         }
+        else if (arg == "--backend" || arg == "-b") {
+            if (!parse_backend(argc, argv, i)) return false;
+        }
+        else if (arg == "--weights" || arg == "-w") {
+            if (!parse_weights(argc, argv, i)) return false;
+        }
+        else if (arg == "--games" || arg == "-g") {
+            if (!parse_games(argc, argv, i)) return false;
+        }
+        else if (arg == "--record" || arg == "-r") {
+            if (!parse_record(argc, argv, i)) return false;
+        }
         else {
             std::cout << "Invalid option. Use --help or -h for usage information.\n";
             return false;
         }
     }
+    // weights alone select the pattern evaluator, which cannot run without them
+    if (eval == Engine::Eval::AUTO && !weights.empty()) {
+        eval = Engine::Eval::PATTERN;
+    }
+    if (eval == Engine::Eval::PATTERN && weights.empty()) {
+        std::cout << "Pattern evaluation needs weights, use --weights or -w.\n";
+        return false;
+    }
+    // statistics of thousands of searches would only slow the self-play down,
+    // suite reports its own summary
+    if (mode == App::Mode::SELF_PLAY || mode == App::Mode::SUITE) {
+        settings.quiet = true;
+    }
     // if we got here, everything was correctly parsed
     return true;
 }
@@ -0,0 +1,85 @@
+/*
+    This file is part of Reversan Engine.
+
+    Reversan Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Reversan Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Reversan Engine. If not, see <https://www.gnu.org/licenses/>. 
+*/
+
+#include "utils/position_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+// records are written byte by byte, so the file does not depend on the host byte order
+static constexpr int RECORD_SIZE = 17;
+
+bool PositionFile::write(const char *path, const std::vector<Record> &records) {
+    std::FILE *file = std::fopen(path, "wb");
+    if (!file) {
+        std::cout << "Could not create positions file " << path << ".\n";
+        return false;
+    }
+    unsigned char header[8];
+    std::copy(FILE_MAGIC, FILE_MAGIC + 4, header);
+    for (int i = 0; i < 4; ++i) header[4 + i] = (FILE_VERSION >> (8 * i)) & 0xff;
+    bool valid = std::fwrite(header, 1, 8, file) == 8;
+
+    for (size_t r = 0; valid && r < records.size(); ++r) {
+        unsigned char buffer[RECORD_SIZE];
+        for (int i = 0; i < 8; ++i) {
+            buffer[i] = (records[r].white >> (8 * i)) & 0xff;
+            buffer[8 + i] = (records[r].black >> (8 * i)) & 0xff;
+        }
+        buffer[16] = static_cast<unsigned char>(records[r].disc_diff);
+        valid = std::fwrite(buffer, 1, RECORD_SIZE, file) == RECORD_SIZE;
+    }
+    valid = std::fclose(file) == 0 && valid;
+    if (!valid) {
+        std::cout << "Could not write positions file " << path << ".\n";
+    }
+    return valid;
+}
+
+bool PositionFile::read(const char *path, std::vector<Record> &records) {
+    std::FILE *file = std::fopen(path, "rb");
+    if (!file) {
+        std::cout << "Could not open positions file " << path << ".\n";
+        return false;
+    }
+    unsigned char header[8];
+    uint32_t version = 0;
+    bool valid = std::fread(header, 1, 8, file) == 8 && std::equal(FILE_MAGIC, FILE_MAGIC + 4, header);
+    for (int i = 3; valid && i >= 0; --i) version = (version << 8) | header[4 + i];
+    if (!valid || version != FILE_VERSION) {
+        std::cout << "File " << path << " is not a compatible positions file.\n";
+        std::fclose(file);
+        return false;
+    }
+
+    unsigned char buffer[RECORD_SIZE];
+    size_t size;
+    while ((size = std::fread(buffer, 1, RECORD_SIZE, file)) == RECORD_SIZE) {
+        Record record = {0, 0, static_cast<int8_t>(buffer[16])};
+        for (int i = 7; i >= 0; --i) {
+            record.white = (record.white << 8) | buffer[i];
+            record.black = (record.black << 8) | buffer[8 + i];
+        }
+        records.push_back(record);
+    }
+    std::fclose(file);
+    if (size != 0) {
+        std::cout << "Positions file " << path << " is truncated.\n";
+        return false;
+    }
+    return true;
+}